@@ -32,7 +32,10 @@ static const void *kYGYogaAssociatedKey = &kYGYogaAssociatedKey;
 - (void)configureLayoutWithBlock:(YGLayoutConfigurationBlock)block
 {
   if (block != nil) {
-    block(self.yoga);
+    YGLayout *const yoga = self.yoga;
+    YGNodeStyleBeginBatch(yoga.node);
+    block(yoga);
+    YGNodeStyleCommit(yoga.node);
   }
 }
 
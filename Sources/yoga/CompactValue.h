@@ -128,6 +128,26 @@ public:
                    payload_.repr & 0x40000000 ? YGUnitPercent : YGUnitPoint};
   }
 
+  // The value in points for an owner of the given size, without converting
+  // to YGValue first: points as they are, percentages of ownerSize, and NaN
+  // for undefined and auto. Zero, auto and undefined are the only payloads
+  // with all exponent bits set, so one test separates them from the values.
+  float resolve(float ownerSize) const noexcept {
+    if ((payload_.repr & SPECIAL_BITS) == SPECIAL_BITS) {
+      return payload_.repr == ZERO_BITS_POINT
+          ? 0.0f
+          : payload_.repr == ZERO_BITS_PERCENT
+              ? 0.0f * ownerSize * 0.01f
+              : std::numeric_limits<float>::quiet_NaN();
+    }
+
+    auto data = payload_;
+    data.repr &= ~PERCENT_BIT;
+    data.repr += BIAS;
+    return payload_.repr & PERCENT_BIT ? data.value * ownerSize * 0.01f
+                                       : data.value;
+  }
+
   bool isUndefined() const noexcept {
     return (
         payload_.repr != AUTO_BITS && payload_.repr != ZERO_BITS_POINT &&
@@ -149,6 +169,8 @@ private:
 
   static constexpr uint32_t BIAS = 0x20000000;
   static constexpr uint32_t PERCENT_BIT = 0x40000000;
+  // The exponent bits of a float, all set for NaNs. Values never set them.
+  static constexpr uint32_t SPECIAL_BITS = 0x7f800000;
 
   // these are signaling NaNs with specific bit pattern as payload they will be
   // silenced whenever going through an FPU operation on ARM + x86
@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace facebook {
+namespace yoga {
+namespace detail {
+
+// A vector that keeps up to N elements inline and only allocates once it
+// grows past that. Most nodes have a handful of children, so storing them
+// inline saves one heap allocation per node, and per copy when a node is
+// cloned.
+//
+// Only the subset of std::vector used by YGNode is provided. Elements must be
+// trivially copyable; they are moved around with std::copy and are never
+// destroyed.
+template <typename T, uint32_t N>
+class SmallVector {
+  static_assert(
+      std::is_trivially_copyable<T>::value,
+      "SmallVector only supports trivially copyable elements");
+
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  SmallVector() noexcept = default;
+
+  SmallVector(std::initializer_list<T> values) {
+    assign(values.begin(), values.end());
+  }
+
+  template <typename InputIt>
+  SmallVector(InputIt first, InputIt last) {
+    assign(first, last);
+  }
+
+  SmallVector(const SmallVector& other) {
+    assign(other.begin(), other.end());
+  }
+
+  SmallVector(SmallVector&& other) noexcept {
+    steal(other);
+  }
+
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) {
+      assign(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept {
+    if (this != &other) {
+      release();
+      steal(other);
+    }
+    return *this;
+  }
+
+  ~SmallVector() {
+    release();
+  }
+
+  iterator begin() noexcept {
+    return data_;
+  }
+  iterator end() noexcept {
+    return data_ + size_;
+  }
+  const_iterator begin() const noexcept {
+    return data_;
+  }
+  const_iterator end() const noexcept {
+    return data_ + size_;
+  }
+
+  size_type size() const noexcept {
+    return size_;
+  }
+  size_type capacity() const noexcept {
+    return capacity_;
+  }
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+  bool isInline() const noexcept {
+    return data_ == inline_;
+  }
+
+  T& operator[](size_type index) noexcept {
+    return data_[index];
+  }
+  const T& operator[](size_type index) const noexcept {
+    return data_[index];
+  }
+
+  const T& at(size_type index) const {
+    if (index >= size_) {
+      throw std::out_of_range("SmallVector::at");
+    }
+    return data_[index];
+  }
+
+  void reserve(size_type count) {
+    if (count > capacity_) {
+      grow(count);
+    }
+  }
+
+  void push_back(const T& value) {
+    if (size_ == capacity_) {
+      grow(size_ + 1);
+    }
+    data_[size_++] = value;
+  }
+
+  iterator insert(const_iterator position, const T& value) {
+    const size_type index = position - data_;
+    if (size_ == capacity_) {
+      grow(size_ + 1);
+    }
+    std::copy_backward(data_ + index, data_ + size_, data_ + size_ + 1);
+    data_[index] = value;
+    size_++;
+    return data_ + index;
+  }
+
+  iterator erase(const_iterator position) {
+    const size_type index = position - data_;
+    std::copy(data_ + index + 1, data_ + size_, data_ + index);
+    size_--;
+    return data_ + index;
+  }
+
+  void clear() noexcept {
+    size_ = 0;
+  }
+
+  // Returns to inline storage if the elements fit, freeing the heap block.
+  void shrink_to_fit() {
+    if (!isInline() && size_ <= N) {
+      T* heap = data_;
+      std::copy(heap, heap + size_, inline_);
+      data_ = inline_;
+      capacity_ = N;
+      delete[] heap;
+    }
+  }
+
+private:
+  T* data_ = inline_;
+  uint32_t size_ = 0;
+  uint32_t capacity_ = N;
+  T inline_[N];
+
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    const size_type count = std::distance(first, last);
+    size_ = 0;
+    reserve(count);
+    std::copy(first, last, data_);
+    size_ = static_cast<uint32_t>(count);
+  }
+
+  void grow(size_type minCapacity) {
+    const size_type capacity =
+        std::max(minCapacity, static_cast<size_type>(capacity_) * 2);
+    T* heap = new T[capacity];
+    std::copy(data_, data_ + size_, heap);
+    release();
+    data_ = heap;
+    capacity_ = static_cast<uint32_t>(capacity);
+  }
+
+  void release() noexcept {
+    if (!isInline()) {
+      delete[] data_;
+    }
+  }
+
+  // Takes over the other vector's heap block, or copies its inline elements,
+  // and leaves it empty and inline.
+  void steal(SmallVector& other) noexcept {
+    if (other.isInline()) {
+      std::copy(other.begin(), other.end(), inline_);
+      data_ = inline_;
+      capacity_ = N;
+    } else {
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+    }
+    size_ = other.size_;
+    other.data_ = other.inline_;
+    other.size_ = 0;
+    other.capacity_ = N;
+  }
+};
+
+} // namespace detail
+} // namespace yoga
+} // namespace facebook
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "Yoga.h"
+
+namespace facebook {
+namespace yoga {
+namespace detail {
+
+// Returns the bits of a float, with every NaN mapped to the same pattern.
+inline uint32_t canonicalFloatBits(float value) {
+  if (YGFloatIsUndefined(value)) {
+    value = YGUndefined;
+  }
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// 64-bit FNV-1a. Only fixed-size values are fed into it, so a hash only
+// depends on the data, never on addresses, and stays valid across processes.
+class StructuralHash {
+public:
+  void add(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      value_ = (value_ ^ bytes[i]) * kPrime;
+    }
+  }
+  void add(uint32_t value) {
+    add(&value, sizeof(value));
+  }
+  void add(uint64_t value) {
+    add(&value, sizeof(value));
+  }
+  void add(float value) {
+    add(canonicalFloatBits(value));
+  }
+  void add(YGValue value) {
+    add(static_cast<uint32_t>(value.unit));
+    add(value.value);
+  }
+
+  uint64_t value() const {
+    return value_;
+  }
+
+private:
+  static constexpr uint64_t kOffset = 14695981039346656037ull;
+  static constexpr uint64_t kPrime = 1099511628211ull;
+  uint64_t value_ = kOffset;
+};
+
+} // namespace detail
+} // namespace yoga
+} // namespace facebook
@@ -16,21 +16,6 @@ YGFlexDirection YGFlexDirectionCross(
       : YGFlexDirectionColumn;
 }
 
-float YGFloatMax(const float a, const float b) {
-  if (!yoga::isUndefined(a) && !yoga::isUndefined(b)) {
-    return fmaxf(a, b);
-  }
-  return yoga::isUndefined(a) ? b : a;
-}
-
-float YGFloatMin(const float a, const float b) {
-  if (!yoga::isUndefined(a) && !yoga::isUndefined(b)) {
-    return fminf(a, b);
-  }
-
-  return yoga::isUndefined(a) ? b : a;
-}
-
 bool YGValueEqual(const YGValue& a, const YGValue& b) {
   if (a.unit != b.unit) {
     return false;
@@ -44,23 +29,6 @@ bool YGValueEqual(const YGValue& a, const YGValue& b) {
   return fabs(a.value - b.value) < 0.0001f;
 }
 
-bool YGFloatsEqual(const float a, const float b) {
-  if (!yoga::isUndefined(a) && !yoga::isUndefined(b)) {
-    return fabs(a - b) < 0.0001f;
-  }
-  return yoga::isUndefined(a) && yoga::isUndefined(b);
-}
-
 float YGFloatSanitize(const float val) {
   return yoga::isUndefined(val) ? 0 : val;
 }
-
-YGFloatOptional YGFloatOptionalMax(YGFloatOptional op1, YGFloatOptional op2) {
-  if (op1 >= op2) {
-    return op1;
-  }
-  if (op2 > op1) {
-    return op2;
-  }
-  return op1.isUndefined() ? op2 : op1;
-}
@@ -59,17 +59,23 @@ inline bool YGValueEqual(
   return YGValueEqual((YGValue) a, (YGValue) b);
 }
 
-// This custom float equality function returns true if either absolute
-// difference between two floats is less than 0.0001f or both are undefined.
-bool YGFloatsEqual(const float a, const float b);
-
-float YGFloatMax(const float a, const float b);
+// The larger of two floats, ignoring an undefined one. `a > b ? a : b` is a
+// single maxss, which yields b if either is undefined, so only an undefined
+// b needs a select on top of it, and neither needs a branch or a libm call.
+inline float YGFloatMax(const float a, const float b) {
+  return yoga::isUndefined(b) ? a : (a > b ? a : b);
+}
 
-YGFloatOptional YGFloatOptionalMax(
+inline YGFloatOptional YGFloatOptionalMax(
     const YGFloatOptional op1,
-    const YGFloatOptional op2);
+    const YGFloatOptional op2) {
+  return YGFloatOptional{YGFloatMax(op1.unwrap(), op2.unwrap())};
+}
 
-float YGFloatMin(const float a, const float b);
+// The smaller of two floats, ignoring an undefined one (see YGFloatMax).
+inline float YGFloatMin(const float a, const float b) {
+  return yoga::isUndefined(b) ? a : (a < b ? a : b);
+}
 
 // This custom float comparision function compares the array of float with
 // YGFloatsEqual, as the default float comparision operator will not work(Look
@@ -88,6 +94,12 @@ bool YGFloatArrayEqual(
 // This function returns 0 if YGFloatIsUndefined(val) is true and val otherwise
 float YGFloatSanitize(const float val);
 
+// The distance from val down to the next whole number, in [0, 1], and
+// undefined if val is undefined or infinite.
+inline float YGFloatFraction(const float val) {
+  return val - floorf(val);
+}
+
 YGFlexDirection YGFlexDirectionCross(
     const YGFlexDirection flexDirection,
     const YGDirection direction);
@@ -113,7 +125,7 @@ inline YGFloatOptional YGResolveValue(
 inline YGFloatOptional YGResolveValue(
     yoga::detail::CompactValue value,
     float ownerSize) {
-  return YGResolveValue((YGValue) value, ownerSize);
+  return YGFloatOptional{value.resolve(ownerSize)};
 }
 
 inline bool YGFlexDirectionIsColumn(const YGFlexDirection flexDirection) {
@@ -5,6 +5,7 @@
  * file in the root directory of this source tree.
  */
 #pragma once
+#include <atomic>
 #include "YGMarker.h"
 #include "Yoga-internal.h"
 #include "Yoga.h"
@@ -39,12 +40,44 @@ public:
   bool useWebDefaults = false;
   bool useLegacyStretchBehaviour = false;
   bool shouldDiffLayoutWithoutLegacyStretchBehaviour = false;
+  // The diff runs for one in every `legacyStretchDiffSamplingRate` layouts
+  // that used the legacy stretch behaviour, starting with the first one.
+  uint32_t legacyStretchDiffSamplingRate = 1;
+  uint32_t legacyStretchDiffCountdown = 0;
   bool printTree = false;
   float pointScaleFactor = 1.0f;
   std::array<bool, facebook::yoga::enums::count<YGExperimentalFeature>()>
       experimentalFeatures = {};
   void* context = nullptr;
   YGMarkerCallbacks markerCallbacks = {nullptr, nullptr};
+  YGLayoutChangedFunc layoutChanged = nullptr;
+  bool memoizeIdenticalSubtrees = false;
+  // Not owned.
+  YGLayoutCacheRef layoutCache = nullptr;
+
+  // Counters behind YGConfigGetStats. They belong to this config object: a
+  // copy starts from zero, and assigning a config keeps the target's counters.
+  struct Stats {
+    std::atomic<uint64_t> layoutPasses{0};
+    std::atomic<uint64_t> nodesVisited{0};
+    std::atomic<uint64_t> measureCalls{0};
+    std::atomic<uint64_t> cacheHits{0};
+    std::atomic<uint64_t> cacheMisses{0};
+    std::atomic<uint64_t> cacheEvictions{0};
+    std::atomic<uint64_t> clones{0};
+    std::atomic<uint64_t> bytesAllocated{0};
+    std::atomic<uint64_t> layoutTimeNs{0};
+
+    Stats() = default;
+    Stats(const Stats&) : Stats() {}
+    Stats& operator=(const Stats&) {
+      return *this;
+    }
+
+    static void add(std::atomic<uint64_t>& counter, uint64_t value) {
+      counter.fetch_add(value, std::memory_order_relaxed);
+    }
+  } stats;
 
   YGConfig(YGLogger logger);
   void log(YGConfig*, YGNode*, YGLogLevel, void*, const char*, va_list);
@@ -24,7 +24,7 @@ public:
   }
 
   bool isUndefined() const {
-    return std::isnan(value_);
+    return yoga::isUndefined(value_);
   }
 
   YGFloatOptional operator+(YGFloatOptional op) const {
@@ -12,15 +12,18 @@ constexpr std::array<float, 2> kYGDefaultDimensionValues = {
     {YGUndefined, YGUndefined}};
 
 struct YGLayout {
+  // Fields read for every child during a layout pass come first so that they
+  // share the node's first cache lines; the measurement cache and the
+  // reported frame, which are only touched on a cache probe or after layout,
+  // come last.
   std::array<float, 4> position = {};
   std::array<float, 2> dimensions = kYGDefaultDimensionValues;
-  std::array<float, 6> margin = {};
-  std::array<float, 6> border = {};
-  std::array<float, 6> padding = {};
+  std::array<float, 2> measuredDimensions = kYGDefaultDimensionValues;
   YGDirection direction : 2;
   bool didUseLegacyFlag : 1;
   bool doesLegacyStretchFlagAffectsLayout : 1;
   bool hadOverflow : 1;
+  bool isVirtualized : 1;
 
   uint32_t computedFlexBasisGeneration = 0;
   YGFloatOptional computedFlexBasis = {};
@@ -30,18 +33,34 @@ struct YGLayout {
   uint32_t generationCount = 0;
   YGDirection lastOwnerDirection = (YGDirection) -1;
 
+  YGCachedMeasurement cachedLayout = YGCachedMeasurement();
+  // Baseline for the current layout, computed on first use and reset
+  // whenever the node is laid out or measured again.
+  float baseline = YGUndefined;
+
+  std::array<float, 6> margin = {};
+  std::array<float, 6> border = {};
+  std::array<float, 6> padding = {};
+
   uint32_t nextCachedMeasurementsIndex = 0;
   std::array<YGCachedMeasurement, YG_MAX_CACHED_RESULT_COUNT>
       cachedMeasurements = {};
-  std::array<float, 2> measuredDimensions = kYGDefaultDimensionValues;
 
-  YGCachedMeasurement cachedLayout = YGCachedMeasurement();
+  // Inputs of the last layout of the node as an absolute child. While they
+  // are unchanged and the node is clean, it is not laid out again.
+  YGAbsoluteLayoutInputs absoluteLayoutInputs = {};
+
+  // Frame (left, top, width, height) last handed to the config's
+  // layoutChanged callback. Not part of the layout itself.
+  std::array<float, 4> reportedFrame = {
+      {YGUndefined, YGUndefined, YGUndefined, YGUndefined}};
 
   YGLayout()
       : direction(YGDirectionInherit),
         didUseLegacyFlag(false),
         doesLegacyStretchFlagAffectsLayout(false),
-        hadOverflow(false) {}
+        hadOverflow(false),
+        isVirtualized(false) {}
 
   bool operator==(YGLayout layout) const;
   bool operator!=(YGLayout layout) const {
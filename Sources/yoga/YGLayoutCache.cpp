@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "YGLayoutCache.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <iterator>
+#include "YGNode.h"
+
+namespace {
+
+// Frame::flags
+constexpr uint32_t kHadOverflow = 1 << 0;
+constexpr uint32_t kIsVirtualized = 1 << 1;
+constexpr uint32_t kDidUseLegacyFlag = 1 << 2;
+
+struct FileHeader {
+  char magic[4];
+  uint32_t version;
+  // Written as 0x01020304, so files from a machine with another byte order
+  // are rejected.
+  uint32_t byteOrder;
+  uint32_t entryCount;
+};
+
+constexpr char kMagic[4] = {'Y', 'G', 'L', 'C'};
+constexpr uint32_t kByteOrder = 0x01020304;
+
+template <typename Fn>
+void forEachPreOrder(YGNodeRef root, Fn fn) {
+  std::vector<YGNodeRef> stack = {root};
+  while (!stack.empty()) {
+    const YGNodeRef node = stack.back();
+    stack.pop_back();
+    fn(node);
+    const YGVector& children = node->getChildren();
+    for (size_t i = children.size(); i > 0; i--) {
+      stack.push_back(children[i - 1]);
+    }
+  }
+}
+
+} // namespace
+
+bool YGLayoutCache::Key::operator==(const Key& other) const {
+  return memcmp(this, &other, sizeof(Key)) == 0;
+}
+
+YGLayoutCache::YGLayoutCache(const char* path) : path_(path ? path : "") {
+  load();
+}
+
+bool YGLayoutCache::restore(YGNodeRef root, const Key& key) const {
+  std::vector<Frame> frames;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto entry = entries_.find(key);
+    if (entry == entries_.end()) {
+      return false;
+    }
+    frames = entry->second;
+  }
+
+  size_t index = 0;
+  forEachPreOrder(root, [&](YGNodeRef node) {
+    const Frame& frame = frames[index++];
+    YGLayout& layout = node->getLayout();
+    std::copy(
+        std::begin(frame.position),
+        std::end(frame.position),
+        layout.position.begin());
+    std::copy(
+        std::begin(frame.dimensions),
+        std::end(frame.dimensions),
+        layout.dimensions.begin());
+    std::copy(
+        std::begin(frame.measuredDimensions),
+        std::end(frame.measuredDimensions),
+        layout.measuredDimensions.begin());
+    std::copy(
+        std::begin(frame.margin),
+        std::end(frame.margin),
+        layout.margin.begin());
+    std::copy(
+        std::begin(frame.border),
+        std::end(frame.border),
+        layout.border.begin());
+    std::copy(
+        std::begin(frame.padding),
+        std::end(frame.padding),
+        layout.padding.begin());
+    layout.direction = static_cast<YGDirection>(frame.direction);
+    layout.hadOverflow = (frame.flags & kHadOverflow) != 0;
+    layout.isVirtualized = (frame.flags & kIsVirtualized) != 0;
+    layout.didUseLegacyFlag = (frame.flags & kDidUseLegacyFlag) != 0;
+    layout.baseline = YGUndefined;
+
+    // The root is finished by its caller. Descendants were not laid out, so
+    // whatever they had cached no longer matches their subtrees: forget it,
+    // and make the next pass that reaches them lay them out again.
+    if (node != root) {
+      // Hidden nodes were zeroed, their descendants were not.
+      node->setLayoutZeroed(node->getStyle().display == YGDisplayNone);
+      layout.nextCachedMeasurementsIndex = 0;
+      layout.cachedLayout = YGCachedMeasurement();
+      layout.lastOwnerDirection = (YGDirection) -1;
+      node->setHasNewLayout(true);
+      node->setDirty(false);
+    }
+  });
+  return true;
+}
+
+void YGLayoutCache::store(YGNodeRef root, const Key& key) {
+  std::vector<Frame> frames;
+  frames.reserve(key.nodeCount);
+  forEachPreOrder(root, [&](YGNodeRef node) {
+    const YGLayout& layout = node->getLayout();
+    Frame frame;
+    std::copy(layout.position.begin(), layout.position.end(), frame.position);
+    std::copy(
+        layout.dimensions.begin(), layout.dimensions.end(), frame.dimensions);
+    std::copy(
+        layout.measuredDimensions.begin(),
+        layout.measuredDimensions.end(),
+        frame.measuredDimensions);
+    std::copy(layout.margin.begin(), layout.margin.end(), frame.margin);
+    std::copy(layout.border.begin(), layout.border.end(), frame.border);
+    std::copy(layout.padding.begin(), layout.padding.end(), frame.padding);
+    frame.direction = layout.direction;
+    frame.flags = (layout.hadOverflow ? kHadOverflow : 0) |
+        (layout.isVirtualized ? kIsVirtualized : 0) |
+        (layout.didUseLegacyFlag ? kDidUseLegacyFlag : 0);
+    frames.push_back(frame);
+  });
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_[key] = std::move(frames);
+}
+
+size_t YGLayoutCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+// The file is read in one go rather than mapped, which works the same on
+// every platform Yoga builds for. A file that is missing, truncated or was
+// written by another format version leaves the cache empty.
+void YGLayoutCache::load() {
+  if (path_.empty()) {
+    return;
+  }
+  FILE* file = fopen(path_.c_str(), "rb");
+  if (file == nullptr) {
+    return;
+  }
+  std::vector<char> contents;
+  char buffer[4096];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    contents.insert(contents.end(), buffer, buffer + read);
+  }
+  fclose(file);
+
+  const char* cursor = contents.data();
+  const char* const end = contents.data() + contents.size();
+  const auto take = [&](void* out, size_t size) {
+    if (static_cast<size_t>(end - cursor) < size) {
+      return false;
+    }
+    memcpy(out, cursor, size);
+    cursor += size;
+    return true;
+  };
+
+  FileHeader header;
+  bool valid = take(&header, sizeof(header)) &&
+      memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+      header.version == kFormatVersion && header.byteOrder == kByteOrder;
+  for (uint32_t i = 0; valid && i < header.entryCount; i++) {
+    Key key;
+    valid = take(&key, sizeof(key)) && key.nodeCount > 0 &&
+        static_cast<size_t>(end - cursor) / sizeof(Frame) >= key.nodeCount;
+    if (valid) {
+      std::vector<Frame> frames(key.nodeCount);
+      take(frames.data(), key.nodeCount * sizeof(Frame));
+      entries_[key] = std::move(frames);
+    }
+  }
+  if (!valid) {
+    entries_.clear();
+  }
+}
+
+// Writes to a temporary file first, so that a crash never leaves a truncated
+// cache behind.
+bool YGLayoutCache::save() const {
+  if (path_.empty()) {
+    return false;
+  }
+  const std::string tempPath = path_ + ".tmp";
+  FILE* file = fopen(tempPath.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  bool written;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FileHeader header;
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.byteOrder = kByteOrder;
+    header.entryCount = static_cast<uint32_t>(entries_.size());
+    written = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (const auto& entry : entries_) {
+      written = written &&
+          fwrite(&entry.first, sizeof(Key), 1, file) == 1 &&
+          fwrite(
+              entry.second.data(),
+              sizeof(Frame),
+              entry.second.size(),
+              file) == entry.second.size();
+    }
+  }
+  written = fclose(file) == 0 && written;
+
+  if (written) {
+    // rename() does not replace an existing file on every platform.
+    remove(path_.c_str());
+    written = rename(tempPath.c_str(), path_.c_str()) == 0;
+  }
+  if (!written) {
+    remove(tempPath.c_str());
+  }
+  return written;
+}
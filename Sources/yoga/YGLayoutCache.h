@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Yoga-internal.h"
+#include "Yoga.h"
+
+struct YGLayoutCache {
+  // Floats are stored as canonical bits so that undefined constraints compare
+  // equal. The struct has no padding and is written to disk as is.
+  struct Key {
+    uint64_t hash;
+    uint32_t availableWidth;
+    uint32_t availableHeight;
+    uint32_t ownerWidth;
+    uint32_t ownerHeight;
+    uint32_t widthMeasureMode;
+    uint32_t heightMeasureMode;
+    uint32_t ownerDirection;
+    uint32_t nodeCount;
+
+    bool operator==(const Key& other) const;
+  };
+
+  // The unrounded layout of one node, as left by YGNodelayoutImpl.
+  struct Frame {
+    float position[4];
+    float dimensions[2];
+    float measuredDimensions[2];
+    float margin[6];
+    float border[6];
+    float padding[6];
+    uint32_t direction;
+    uint32_t flags;
+  };
+
+  // Bump whenever the file layout or the layout algorithm changes, so that
+  // files written by other versions are ignored.
+  static constexpr uint32_t kFormatVersion = 2;
+
+  explicit YGLayoutCache(const char* path);
+
+  // Returns true and lays out the subtree if an entry matches the key.
+  bool restore(YGNodeRef root, const Key& key) const;
+  void store(YGNodeRef root, const Key& key);
+
+  bool save() const;
+  size_t size() const;
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      return static_cast<size_t>(key.hash);
+    }
+  };
+
+private:
+  const std::string path_;
+  mutable std::mutex mutex_;
+  std::unordered_map<Key, std::vector<Frame>, KeyHasher> entries_;
+
+  void load();
+};
@@ -25,6 +25,12 @@ typedef struct {
   int maxMeasureCache;
   int cachedLayouts;
   int cachedMeasures;
+  // Absolute children whose owner and own layout were unchanged, and that
+  // were positioned without being laid out again.
+  int skippedAbsoluteLayouts;
+  // Lines of wrapping containers that broke at the same children as in the
+  // container's previous layout, and were not searched for again.
+  int reusedFlexLines;
 } YGMarkerLayoutData;
 
 typedef struct {
@@ -8,13 +8,14 @@
 #include <algorithm>
 #include <iostream>
 #include "CompactValue.h"
+#include "StructuralHash.h"
 #include "Utils.h"
 
 using namespace facebook;
 using facebook::yoga::detail::CompactValue;
+using facebook::yoga::detail::StructuralHash;
 
 YGNode::YGNode(YGNode&& node) {
-  context_ = node.context_;
   hasNewLayout_ = node.hasNewLayout_;
   isReferenceBaseline_ = node.isReferenceBaseline_;
   isDirty_ = node.isDirty_;
@@ -22,17 +23,30 @@ YGNode::YGNode(YGNode&& node) {
   measureUsesContext_ = node.measureUsesContext_;
   baselineUsesContext_ = node.baselineUsesContext_;
   printUsesContext_ = node.printUsesContext_;
-  measure_ = node.measure_;
-  baseline_ = node.baseline_;
-  print_ = node.print_;
-  dirtied_ = node.dirtied_;
-  style_ = node.style_;
-  layout_ = node.layout_;
+  isStyleBatchOpen_ = node.isStyleBatchOpen_;
+  hasPendingStyleChange_ = node.hasPendingStyleChange_;
+  hasStructuralHash_ = node.hasStructuralHash_;
+  isStructuralHashComplete_ = node.isStructuralHashComplete_;
+  hasBaselineLayout_ = node.hasBaselineLayout_;
+  isBaselineLayout_ = node.isBaselineLayout_;
+  isLayoutZeroed_ = node.isLayoutZeroed_;
   lineIndex_ = node.lineIndex_;
+  measure_ = node.measure_;
   owner_ = node.owner_;
-  children_ = std::move(node.children_);
   config_ = node.config_;
+  children_ = std::move(node.children_);
   resolvedDimensions_ = node.resolvedDimensions_;
+  style_ = node.style_;
+  layout_ = node.layout_;
+  context_ = node.context_;
+  baseline_ = node.baseline_;
+  print_ = node.print_;
+  dirtied_ = node.dirtied_;
+  viewport_ = node.viewport_;
+  flexLines_ = std::move(node.flexLines_);
+  contentKey_ = node.contentKey_;
+  structuralHash_ = node.structuralHash_;
+  subtreeSize_ = node.subtreeSize_;
   for (auto c : children_) {
     c->setOwner(c);
   }
@@ -175,6 +189,7 @@ void YGNode::setMeasureFunc(decltype(YGNode::measure_) measureFunc) {
   }
 
   measure_ = measureFunc;
+  invalidateStructuralHash();
 }
 
 void YGNode::setMeasureFunc(YGMeasureFunc measureFunc) {
@@ -214,7 +229,7 @@ void YGNode::setDirty(bool isDirty) {
 }
 
 bool YGNode::removeChild(YGNodeRef child) {
-  std::vector<YGNodeRef>::iterator p =
+  YGVector::iterator p =
       std::find(children_.begin(), children_.end(), child);
   if (p != children_.end()) {
     children_.erase(p);
@@ -269,6 +284,10 @@ void YGNode::setLayoutHadOverflow(bool hadOverflow) {
   layout_.hadOverflow = hadOverflow;
 }
 
+void YGNode::setLayoutIsVirtualized(bool isVirtualized) {
+  layout_.isVirtualized = isVirtualized;
+}
+
 void YGNode::setLayoutDimension(float dimension, int index) {
   layout_.dimensions[index] = dimension;
 }
@@ -385,6 +404,14 @@ void YGNode::cloneChildrenIfNeeded(void* cloneContext) {
 }
 
 void YGNode::markDirtyAndPropogate() {
+  // Dirty ancestors stop the propagation below, but they may still have a
+  // hash, so it is invalidated separately.
+  invalidateStructuralHash();
+  // The owner's baseline layout depends on the alignment of its children.
+  hasBaselineLayout_ = false;
+  if (owner_) {
+    owner_->hasBaselineLayout_ = false;
+  }
   if (!isDirty_) {
     setDirty(true);
     setLayoutComputedFlexBasis(YGFloatOptional());
@@ -394,9 +421,132 @@ void YGNode::markDirtyAndPropogate() {
   }
 }
 
+bool YGNode::computeIsBaselineLayout() const {
+  if (YGFlexDirectionIsColumn(style_.flexDirection)) {
+    return false;
+  }
+  if (style_.alignItems == YGAlignBaseline) {
+    return true;
+  }
+  for (const YGNodeRef child : children_) {
+    if (child->getStyle().positionType == YGPositionTypeRelative &&
+        child->getStyle().alignSelf == YGAlignBaseline) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void YGNode::invalidateStructuralHash() {
+  for (YGNode* node = this; node != nullptr && node->hasStructuralHash_;
+       node = node->owner_) {
+    node->hasStructuralHash_ = false;
+  }
+}
+
+namespace {
+
+void hashStyle(StructuralHash& hash, const YGStyle& style) {
+  for (uint32_t value : {static_cast<uint32_t>(style.direction),
+                         static_cast<uint32_t>(style.flexDirection),
+                         static_cast<uint32_t>(style.justifyContent),
+                         static_cast<uint32_t>(style.alignContent),
+                         static_cast<uint32_t>(style.alignItems),
+                         static_cast<uint32_t>(style.alignSelf),
+                         static_cast<uint32_t>(style.positionType),
+                         static_cast<uint32_t>(style.flexWrap),
+                         static_cast<uint32_t>(style.overflow),
+                         static_cast<uint32_t>(style.display)}) {
+    hash.add(value);
+  }
+  for (const YGFloatOptional value :
+       {style.flex, style.flexGrow, style.flexShrink, style.aspectRatio}) {
+    hash.add(value.unwrap());
+  }
+  hash.add(YGValue(style.flexBasis));
+  for (uint32_t i = 0; i < yoga::enums::count<YGEdge>(); i++) {
+    hash.add(YGValue(style.margin[i]));
+    hash.add(YGValue(style.position[i]));
+    hash.add(YGValue(style.padding[i]));
+    hash.add(YGValue(style.border[i]));
+  }
+  for (uint32_t i = 0; i < 2; i++) {
+    hash.add(YGValue(style.dimensions[i]));
+    hash.add(YGValue(style.minDimensions[i]));
+    hash.add(YGValue(style.maxDimensions[i]));
+  }
+}
+
+void hashConfig(StructuralHash& hash, const YGConfig& config) {
+  hash.add(static_cast<uint32_t>(config.useWebDefaults));
+  hash.add(static_cast<uint32_t>(config.useLegacyStretchBehaviour));
+  hash.add(config.pointScaleFactor);
+  for (const bool enabled : config.experimentalFeatures) {
+    hash.add(static_cast<uint32_t>(enabled));
+  }
+}
+
+} // namespace
+
+// Combines what this node contributes to layout with the hashes of its
+// children, so that a change deep in a tree only rehashes its ancestors.
+void YGNode::computeStructuralHash() {
+  StructuralHash hash;
+  hashStyle(hash, style_);
+  hashConfig(hash, *config_);
+  for (const float value : {viewport_.offset,
+                            viewport_.length,
+                            viewport_.overscan,
+                            viewport_.estimatedChildSize}) {
+    hash.add(value);
+  }
+  hash.add(static_cast<uint32_t>(nodeType_));
+  hash.add(static_cast<uint32_t>(isReferenceBaseline_));
+  hash.add(static_cast<uint32_t>(hasMeasureFunc()));
+  hash.add(static_cast<uint32_t>(hasBaselineFunc()));
+  hash.add(contentKey_);
+
+  bool isComplete =
+      contentKey_ != 0 || (!hasMeasureFunc() && !hasBaselineFunc());
+  uint32_t subtreeSize = 1;
+  hash.add(static_cast<uint32_t>(children_.size()));
+  for (const YGNodeRef child : children_) {
+    hash.add(child->getStructuralHash());
+    isComplete = isComplete && child->isStructuralHashComplete_;
+    subtreeSize += child->subtreeSize_;
+  }
+
+  structuralHash_ = hash.value();
+  isStructuralHashComplete_ = isComplete;
+  subtreeSize_ = subtreeSize;
+  hasStructuralHash_ = true;
+}
+
+void YGNode::markStyleDirtyAndPropogate() {
+  if (isStyleBatchOpen_) {
+    hasPendingStyleChange_ = true;
+  } else {
+    markDirtyAndPropogate();
+  }
+}
+
+void YGNode::beginStyleBatch() {
+  isStyleBatchOpen_ = true;
+}
+
+bool YGNode::commitStyleBatch() {
+  const bool hadPendingStyleChange = hasPendingStyleChange_;
+  isStyleBatchOpen_ = false;
+  hasPendingStyleChange_ = false;
+  if (hadPendingStyleChange) {
+    markDirtyAndPropogate();
+  }
+  return hadPendingStyleChange;
+}
+
 void YGNode::markDirtyAndPropogateDownwards() {
   isDirty_ = true;
-  for_each(children_.begin(), children_.end(), [](YGNodeRef childNode) {
+  std::for_each(children_.begin(), children_.end(), [](YGNodeRef childNode) {
     childNode->markDirtyAndPropogateDownwards();
   });
 }
@@ -435,33 +585,34 @@ bool YGNode::isNodeFlexible() {
       (resolveFlexGrow() != 0 || resolveFlexShrink() != 0));
 }
 
+// Borders are always in points, so they resolve without an owner size.
 float YGNode::getLeadingBorder(const YGFlexDirection axis) const {
-  YGValue leadingBorder;
-  if (YGFlexDirectionIsRow(axis) && !style_.border[YGEdgeStart].isUndefined()) {
-    leadingBorder = style_.border[YGEdgeStart];
-    if (leadingBorder.value >= 0) {
-      return leadingBorder.value;
+  if (YGFlexDirectionIsRow(axis)) {
+    const float leadingBorder = style_.border[YGEdgeStart].resolve(YGUndefined);
+    if (leadingBorder >= 0) {
+      return leadingBorder;
     }
   }
 
-  leadingBorder =
-      YGComputedEdgeValue(style_.border, leading[axis], CompactValue::ofZero());
-  return YGFloatMax(leadingBorder.value, 0.0f);
+  return YGFloatMax(
+      YGComputedEdgeValue(style_.border, leading[axis], CompactValue::ofZero())
+          .resolve(YGUndefined),
+      0.0f);
 }
 
 float YGNode::getTrailingBorder(const YGFlexDirection flexDirection) const {
-  YGValue trailingBorder;
-  if (YGFlexDirectionIsRow(flexDirection) &&
-      !style_.border[YGEdgeEnd].isUndefined()) {
-    trailingBorder = style_.border[YGEdgeEnd];
-    if (trailingBorder.value >= 0.0f) {
-      return trailingBorder.value;
+  if (YGFlexDirectionIsRow(flexDirection)) {
+    const float trailingBorder = style_.border[YGEdgeEnd].resolve(YGUndefined);
+    if (trailingBorder >= 0.0f) {
+      return trailingBorder;
     }
   }
 
-  trailingBorder = YGComputedEdgeValue(
-      style_.border, trailing[flexDirection], CompactValue::ofZero());
-  return YGFloatMax(trailingBorder.value, 0.0f);
+  return YGFloatMax(
+      YGComputedEdgeValue(
+          style_.border, trailing[flexDirection], CompactValue::ofZero())
+          .resolve(YGUndefined),
+      0.0f);
 }
 
 YGFloatOptional YGNode::getLeadingPadding(
@@ -529,7 +680,7 @@ bool YGNode::didUseLegacyFlag() {
 
 void YGNode::setAndPropogateUseLegacyFlag(bool useLegacyFlag) {
   config_->useLegacyStretchBehaviour = useLegacyFlag;
-  for_each(children_.begin(), children_.end(), [=](YGNodeRef childNode) {
+  std::for_each(children_.begin(), children_.end(), [=](YGNodeRef childNode) {
     childNode->getConfig()->useLegacyStretchBehaviour = useLegacyFlag;
   });
 }
@@ -556,7 +707,7 @@ bool YGNode::isLayoutTreeEqualToNode(const YGNode& node) const {
 
   bool isLayoutTreeEqual = true;
   YGNodeRef otherNodeChildren = nullptr;
-  for (std::vector<YGNodeRef>::size_type i = 0; i < children_.size(); ++i) {
+  for (YGVector::size_type i = 0; i < children_.size(); ++i) {
     otherNodeChildren = node.children_[i];
     isLayoutTreeEqual =
         children_[i]->isLayoutTreeEqualToNode(*otherNodeChildren);
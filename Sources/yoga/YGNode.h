@@ -18,7 +18,9 @@ struct YGNode {
   using PrintWithContextFn = void (*)(YGNode*, void*);
 
 private:
-  void* context_ = nullptr;
+  // Hot fields: everything the layout algorithm reads for each child in
+  // STEPs 3 to 7 is packed at the front of the node, ending with the hot
+  // prefix of YGLayout.
   bool hasNewLayout_ : 1;
   bool isReferenceBaseline_ : 1;
   bool isDirty_ : 1;
@@ -26,10 +28,28 @@ private:
   bool measureUsesContext_ : 1;
   bool baselineUsesContext_ : 1;
   bool printUsesContext_ : 1;
+  bool isStyleBatchOpen_ : 1;
+  bool hasPendingStyleChange_ : 1;
+  bool hasStructuralHash_ : 1;
+  bool isStructuralHashComplete_ : 1;
+  bool hasBaselineLayout_ : 1;
+  bool isBaselineLayout_ : 1;
+  bool isLayoutZeroed_ : 1;
+  uint32_t lineIndex_ = 0;
   union {
     YGMeasureFunc noContext;
     MeasureWithContextFn withContext;
   } measure_ = {nullptr};
+  YGNodeRef owner_ = nullptr;
+  YGConfigRef config_ = nullptr;
+  YGVector children_ = {};
+  std::array<YGValue, 2> resolvedDimensions_ = {
+      {YGValueUndefined, YGValueUndefined}};
+  YGStyle style_ = {};
+  YGLayout layout_ = {};
+
+  // Cold fields: callbacks and state only touched outside the per-child loops.
+  void* context_ = nullptr;
   union {
     YGBaselineFunc noContext;
     BaselineWithContextFn withContext;
@@ -39,14 +59,22 @@ private:
     PrintWithContextFn withContext;
   } print_ = {nullptr};
   YGDirtiedFunc dirtied_ = nullptr;
-  YGStyle style_ = {};
-  YGLayout layout_ = {};
-  uint32_t lineIndex_ = 0;
-  YGNodeRef owner_ = nullptr;
-  YGVector children_ = {};
-  YGConfigRef config_ = nullptr;
-  std::array<YGValue, 2> resolvedDimensions_ = {
-      {YGValueUndefined, YGValueUndefined}};
+  YGViewport viewport_ = {0, YGUndefined, 0, 0};
+  YGFlexLines flexLines_ = {};
+  // Handle of the node in the YGNodePool that allocated it. Copies are never
+  // pooled, so the handle is not carried over; reset() keeps it.
+  struct PoolHandle {
+    YGNodeHandle value = YGNodeHandleUndefined;
+    PoolHandle() = default;
+    PoolHandle(const PoolHandle&) {}
+    PoolHandle& operator=(const PoolHandle&) {
+      return *this;
+    }
+  } poolHandle_;
+  uint64_t contentKey_ = 0;
+  // Cached by computeStructuralHash while hasStructuralHash_ is set.
+  uint64_t structuralHash_ = 0;
+  uint32_t subtreeSize_ = 0;
 
   YGFloatOptional relativePosition(
       const YGFlexDirection axis,
@@ -54,6 +82,8 @@ private:
 
   void setMeasureFunc(decltype(measure_));
   void setBaselineFunc(decltype(baseline_));
+  void computeStructuralHash();
+  bool computeIsBaselineLayout() const;
 
   // DANGER DANGER DANGER!
   // If the the node assigned to has children, we'd either have to deallocate
@@ -70,7 +100,14 @@ public:
         nodeType_{YGNodeTypeDefault},
         measureUsesContext_{false},
         baselineUsesContext_{false},
-        printUsesContext_{false} {}
+        printUsesContext_{false},
+        isStyleBatchOpen_{false},
+        hasPendingStyleChange_{false},
+        hasStructuralHash_{false},
+        isStructuralHashComplete_{false},
+        hasBaselineLayout_{false},
+        isBaselineLayout_{false},
+        isLayoutZeroed_{false} {}
   ~YGNode() = default; // cleanup of owner/children relationships in YGNodeFree
   explicit YGNode(const YGConfigRef newConfig) : config_(newConfig){};
 
@@ -133,6 +170,14 @@ public:
     return layout_;
   }
 
+  const YGViewport& getViewport() const {
+    return viewport_;
+  }
+
+  YGFlexLines& getFlexLines() {
+    return flexLines_;
+  }
+
   uint32_t getLineIndex() const {
     return lineIndex_;
   }
@@ -182,10 +227,69 @@ public:
     return config_;
   }
 
+  bool isPooled() const {
+    return poolHandle_.value != YGNodeHandleUndefined;
+  }
+
+  YGNodeHandle getPoolHandle() const {
+    return poolHandle_.value;
+  }
+
   bool isDirty() const {
     return isDirty_;
   }
 
+  // Set on a display: none node whose layout was zeroed. Its descendants are
+  // left as they were and read as zero until the node is laid out again.
+  bool isLayoutZeroed() const {
+    return isLayoutZeroed_;
+  }
+
+  bool isStyleBatchOpen() const {
+    return isStyleBatchOpen_;
+  }
+
+  uint64_t getContentKey() const {
+    return contentKey_;
+  }
+
+  // Hash of the subtree, as returned by YGNodeGetStructuralHash. It is
+  // computed on first use, along with the hashes of all descendants, and kept
+  // until invalidateStructuralHash reports a change in the subtree.
+  uint64_t getStructuralHash() {
+    if (!hasStructuralHash_) {
+      computeStructuralHash();
+    }
+    return structuralHash_;
+  }
+
+  // False if a node in the subtree has a measure or baseline function but no
+  // content key: its results, and so the subtree's layout, are not covered by
+  // the hash.
+  bool isStructuralHashComplete() {
+    if (!hasStructuralHash_) {
+      computeStructuralHash();
+    }
+    return isStructuralHashComplete_;
+  }
+
+  uint32_t getSubtreeSize() {
+    if (!hasStructuralHash_) {
+      computeStructuralHash();
+    }
+    return subtreeSize_;
+  }
+
+  // Whether children are aligned by their baselines. Computed on first use
+  // and kept until the node or one of its children is marked dirty.
+  bool isBaselineLayout() {
+    if (!hasBaselineLayout_) {
+      isBaselineLayout_ = computeIsBaselineLayout();
+      hasBaselineLayout_ = true;
+    }
+    return isBaselineLayout_;
+  }
+
   std::array<YGValue, 2> getResolvedDimensions() const {
     return resolvedDimensions_;
   }
@@ -248,8 +352,13 @@ public:
     hasNewLayout_ = hasNewLayout;
   }
 
+  void setLayoutZeroed(bool isLayoutZeroed) {
+    isLayoutZeroed_ = isLayoutZeroed;
+  }
+
   void setNodeType(YGNodeType nodeType) {
     nodeType_ = nodeType;
+    invalidateStructuralHash();
   }
 
   void setStyleFlexDirection(YGFlexDirection direction) {
@@ -269,10 +378,12 @@ public:
   void setBaselineFunc(YGBaselineFunc baseLineFunc) {
     baselineUsesContext_ = false;
     baseline_.noContext = baseLineFunc;
+    invalidateStructuralHash();
   }
   void setBaselineFunc(BaselineWithContextFn baseLineFunc) {
     baselineUsesContext_ = true;
     baseline_.withContext = baseLineFunc;
+    invalidateStructuralHash();
   }
   void setBaselineFunc(std::nullptr_t) {
     return setBaselineFunc(YGBaselineFunc{nullptr});
@@ -290,6 +401,10 @@ public:
     layout_ = layout;
   }
 
+  void setViewport(const YGViewport& viewport) {
+    viewport_ = viewport;
+  }
+
   void setLineIndex(uint32_t lineIndex) {
     lineIndex_ = lineIndex;
   }
@@ -306,10 +421,28 @@ public:
     children_ = children;
   }
 
-  // TODO: rvalue override for setChildren
+  void setChildren(YGVector&& children) {
+    children_ = std::move(children);
+  }
+
+  void reserveChildren(size_t count) {
+    children_.reserve(count);
+  }
 
   void setConfig(YGConfigRef config) {
     config_ = config;
+    invalidateStructuralHash();
+  }
+
+  void setContentKey(uint64_t contentKey) {
+    if (contentKey != contentKey_) {
+      contentKey_ = contentKey;
+      invalidateStructuralHash();
+    }
+  }
+
+  void setPoolHandle(YGNodeHandle handle) {
+    poolHandle_.value = handle;
   }
 
   void setDirty(bool isDirty);
@@ -319,6 +452,7 @@ public:
       uint32_t computedFlexBasisGeneration);
   void setLayoutMeasuredDimension(float measuredDimension, int index);
   void setLayoutHadOverflow(bool hadOverflow);
+  void setLayoutIsVirtualized(bool isVirtualized);
   void setLayoutDimension(float dimension, int index);
   void setLayoutDirection(YGDirection direction);
   void setLayoutMargin(float margin, int index);
@@ -352,6 +486,16 @@ public:
 
   void cloneChildrenIfNeeded(void*);
   void markDirtyAndPropogate();
+  // Drops the cached structural hash of this node and its ancestors. A node
+  // only has a hash if all its descendants do, so the walk stops at the first
+  // node without one.
+  void invalidateStructuralHash();
+  // Style setters call this instead of markDirtyAndPropogate(). While a style
+  // batch is open the change is only recorded, and commitStyleBatch()
+  // propagates it once for the whole batch.
+  void markStyleDirtyAndPropogate();
+  void beginStyleBatch();
+  bool commitStyleBatch();
   float resolveFlexGrow();
   float resolveFlexShrink();
   bool isNodeFlexible();
@@ -8,11 +8,15 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include "CompactValue.h"
+#include "SmallVector.h"
 #include "Yoga.h"
 
-using YGVector = std::vector<YGNodeRef>;
+// Child lists keep up to four children inline, which covers most nodes.
+using YGVector = facebook::yoga::detail::SmallVector<YGNodeRef, 4>;
 
 YG_EXTERN_C_BEGIN
 
@@ -36,8 +40,14 @@ YG_EXTERN_C_END
 namespace facebook {
 namespace yoga {
 
+// Tests the bit pattern rather than calling std::isnan, so that the check is
+// an inlined integer compare on every toolchain, including with
+// -ffinite-math-only. Any NaN is undefined, not only YGUndefined, as
+// arithmetic on undefined values yields other NaNs.
 inline bool isUndefined(float value) {
-  return std::isnan(value);
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return (bits & 0x7fffffff) > 0x7f800000;
 }
 
 } // namespace yoga
@@ -93,6 +103,38 @@ struct YGCachedMeasurement {
   }
 };
 
+// What YGNodeAbsoluteLayoutChild reads from the owner of an absolute child to
+// size it, and the size it arrived at.
+struct YGAbsoluteLayoutInputs {
+  // Inner width and height, measured width and height, and the sums of the
+  // row and column borders of the owner.
+  std::array<float, 6> ownerSizes = {
+      {YGUndefined, YGUndefined, YGUndefined, YGUndefined, 0, 0}};
+  YGMeasureMode widthMeasureMode = (YGMeasureMode) -1;
+  YGDirection direction = YGDirectionInherit;
+  bool isMainAxisRow = false;
+
+  std::array<float, 2> childSize = {{YGUndefined, YGUndefined}};
+};
+
+// The lines a wrapping container was broken into by its last layout, and the
+// outer main sizes of its children they were computed from. The next layout
+// keeps the leading lines that still break at the same children, and only
+// searches for the breaks after them (see YGNodeCollectFlexLines).
+struct YGFlexLine {
+  // Index of the first child after the line.
+  uint32_t endIndex;
+  uint32_t itemCount;
+  // Sum of the outer main sizes of the items, added up in order.
+  float size;
+};
+
+struct YGFlexLines {
+  // NaN for children that are not on any line (absolute or display: none).
+  std::vector<float> outerMainSizes;
+  std::vector<YGFlexLine> lines;
+};
+
 // This value was chosen based on empiracle data. Even the most complicated
 // layouts should not require more than 16 entries to fit within the cache.
 #define YG_MAX_CACHED_RESULT_COUNT 16
@@ -154,7 +196,14 @@ static const float kDefaultFlexGrow = 0.0f;
 static const float kDefaultFlexShrink = 0.0f;
 static const float kWebDefaultFlexShrink = 1.0f;
 
-extern bool YGFloatsEqual(const float a, const float b);
+// This custom float equality function returns true if either absolute
+// difference between two floats is less than 0.0001f or both are undefined.
+inline bool YGFloatsEqual(const float a, const float b) {
+  if (!yoga::isUndefined(a) && !yoga::isUndefined(b)) {
+    return fabsf(a - b) < 0.0001f;
+  }
+  return yoga::isUndefined(a) && yoga::isUndefined(b);
+}
 extern facebook::yoga::detail::CompactValue YGComputedEdgeValue(
     const facebook::yoga::detail::Values<
         facebook::yoga::enums::count<YGEdge>()>& edges,
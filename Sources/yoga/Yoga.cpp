@@ -9,7 +9,16 @@
 #include <float.h>
 #include <string.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+#include "StructuralHash.h"
 #include "Utils.h"
+#include "YGLayoutCache.h"
 #include "YGNode.h"
 #include "YGNodePrint.h"
 #include "Yoga-internal.h"
@@ -26,6 +35,7 @@ __forceinline const float fmaxf(const float a, const float b) {
 #endif
 
 using namespace facebook::yoga;
+using detail::canonicalFloatBits;
 using detail::Log;
 
 namespace {
@@ -194,6 +204,22 @@ void YGNodeSetHasNewLayout(YGNodeRef node, bool hasNewLayout) {
   node->setHasNewLayout(hasNewLayout);
 }
 
+void YGNodeSetViewport(YGNodeRef node, YGViewport viewport) {
+  const YGViewport& current = node->getViewport();
+  if (YGFloatsEqual(current.offset, viewport.offset) &&
+      YGFloatsEqual(current.length, viewport.length) &&
+      YGFloatsEqual(current.overscan, viewport.overscan) &&
+      YGFloatsEqual(current.estimatedChildSize, viewport.estimatedChildSize)) {
+    return;
+  }
+  node->setViewport(viewport);
+  node->markDirtyAndPropogate();
+}
+
+YGViewport YGNodeGetViewport(YGNodeRef node) {
+  return node->getViewport();
+}
+
 YGNodeType YGNodeGetNodeType(YGNodeRef node) {
   return node->getNodeType();
 }
@@ -214,14 +240,15 @@ void YGNodeMarkDirtyAndPropogateToDescendants(const YGNodeRef node) {
   return node->markDirtyAndPropogateDownwards();
 }
 
-int32_t gNodeInstanceCount = 0;
-int32_t gConfigInstanceCount = 0;
+std::atomic<int32_t> gNodeInstanceCount(0);
+std::atomic<int32_t> gConfigInstanceCount(0);
 
 WIN_EXPORT YGNodeRef YGNodeNewWithConfig(const YGConfigRef config) {
   const YGNodeRef node = new YGNode();
   YGAssertWithConfig(
       config, node != nullptr, "Could not allocate memory for node");
   gNodeInstanceCount++;
+  YGConfig::Stats::add(config->stats.bytesAllocated, sizeof(YGNode));
 
   if (config->useWebDefaults) {
     node->setStyleFlexDirection(YGFlexDirectionRow);
@@ -247,40 +274,19 @@ YGNodeRef YGNodeClone(YGNodeRef oldNode) {
       node != nullptr,
       "Could not allocate memory for node");
   gNodeInstanceCount++;
-  node->setOwner(nullptr);
-  return node;
-}
-
-static YGConfigRef YGConfigClone(const YGConfig& oldConfig) {
-  const YGConfigRef config = new YGConfig(oldConfig);
-  YGAssert(config != nullptr, "Could not allocate memory for config");
-  if (config == nullptr) {
-    abort();
-  }
-  gConfigInstanceCount++;
-  return config;
-}
-
-static YGNodeRef YGNodeDeepClone(YGNodeRef oldNode) {
-  YGNodeRef node = YGNodeClone(oldNode);
-  YGVector vec = YGVector();
-  vec.reserve(oldNode->getChildren().size());
-  YGNodeRef childNode = nullptr;
-  for (auto* item : oldNode->getChildren()) {
-    childNode = YGNodeDeepClone(item);
-    childNode->setOwner(node);
-    vec.push_back(childNode);
+  if (YGConfigRef config = oldNode->getConfig()) {
+    YGConfig::Stats::add(config->stats.clones, 1);
+    YGConfig::Stats::add(config->stats.bytesAllocated, sizeof(YGNode));
   }
-  node->setChildren(vec);
-
-  if (oldNode->getConfig() != nullptr) {
-    node->setConfig(YGConfigClone(*(oldNode->getConfig())));
-  }
-
+  node->setOwner(nullptr);
   return node;
 }
 
 void YGNodeFree(const YGNodeRef node) {
+  YGAssertWithNode(
+      node,
+      !node->isPooled(),
+      "Nodes allocated from a YGNodePool are freed with YGNodePoolFree");
   if (YGNodeRef owner = node->getOwner()) {
     owner->removeChild(node);
     node->setOwner(nullptr);
@@ -297,41 +303,105 @@ void YGNodeFree(const YGNodeRef node) {
   gNodeInstanceCount--;
 }
 
-static void YGConfigFreeRecursive(const YGNodeRef root) {
-  if (root->getConfig() != nullptr) {
-    gConfigInstanceCount--;
-    delete root->getConfig();
-  }
-  // Delete configs recursively for childrens
-  for (auto* child : root->getChildren()) {
-    YGConfigFreeRecursive(child);
-  }
-}
-
-void YGNodeFreeRecursiveWithCleanupFunc(
+// Frees `root` and every node it owns, directly or through owned children.
+// Nothing inside the tree is detached, reset or marked dirty on the way: the
+// whole tree goes away, so none of that work would be observable. Shared
+// children owned by another tree are left untouched. `root` must already be
+// detached from its owner.
+static void YGNodeFreeOwnedTree(
     const YGNodeRef root,
     YGNodeCleanupFunc cleanup) {
-  uint32_t skipped = 0;
-  while (YGNodeGetChildCount(root) > skipped) {
-    const YGNodeRef child = YGNodeGetChild(root, skipped);
-    if (child->getOwner() != root) {
-      // Don't free shared nodes that we don't own.
-      skipped += 1;
+  // Owned descendants in breadth-first order, so every node comes after its
+  // owner and can be freed walking the list backwards.
+  std::vector<YGNodeRef> descendants;
+  YGVector sharedChildren;
+  for (const YGNodeRef child : root->getChildren()) {
+    if (child->getOwner() == root) {
+      descendants.push_back(child);
     } else {
-      YGNodeRemoveChild(root, child);
-      YGNodeFreeRecursive(child);
+      sharedChildren.push_back(child);
+    }
+  }
+  for (size_t i = 0; i < descendants.size(); i++) {
+    const YGNodeRef node = descendants[i];
+    for (const YGNodeRef child : node->getChildren()) {
+      if (child->getOwner() == node) {
+        descendants.push_back(child);
+      }
     }
   }
+
+  for (auto it = descendants.rbegin(); it != descendants.rend(); ++it) {
+    YGAssertWithNode(
+        *it,
+        !(*it)->isPooled(),
+        "Nodes allocated from a YGNodePool are freed with YGNodePoolFree");
+    delete *it;
+  }
+  gNodeInstanceCount -= static_cast<int32_t>(descendants.size());
+
+  // As with YGNodeFreeRecursive, the cleanup function sees the root with only
+  // its shared children left.
+  root->setChildren(std::move(sharedChildren));
   if (cleanup != nullptr) {
     cleanup(root);
   }
-  YGNodeFree(root);
+  delete root;
+  gNodeInstanceCount--;
+}
+
+void YGNodeFreeRecursiveWithCleanupFunc(
+    const YGNodeRef root,
+    YGNodeCleanupFunc cleanup) {
+  YGAssertWithNode(
+      root,
+      !root->isPooled(),
+      "Nodes allocated from a YGNodePool are freed with YGNodePoolFree");
+  if (YGNodeRef owner = root->getOwner()) {
+    owner->removeChild(root);
+    root->setOwner(nullptr);
+  }
+  YGNodeFreeOwnedTree(root, cleanup);
 }
 
 void YGNodeFreeRecursive(const YGNodeRef root) {
   return YGNodeFreeRecursiveWithCleanupFunc(root, nullptr);
 }
 
+namespace {
+struct YGFreeTreeTask {
+  YGNodeRef root;
+  YGNodeCleanupFunc cleanup;
+};
+} // namespace
+
+static void YGFreeTree(void* taskContext, uint32_t) {
+  const YGFreeTreeTask* task = static_cast<YGFreeTreeTask*>(taskContext);
+  YGNodeFreeOwnedTree(task->root, task->cleanup);
+  delete task;
+}
+
+void YGNodeFreeRecursiveAsync(
+    const YGNodeRef root,
+    YGNodeCleanupFunc cleanup,
+    const YGDispatcher* dispatcher) {
+  YGAssertWithNode(
+      root,
+      !root->isPooled(),
+      "Nodes allocated from a YGNodePool are freed with YGNodePoolFree");
+  if (YGNodeRef owner = root->getOwner()) {
+    owner->removeChild(root);
+    root->setOwner(nullptr);
+  }
+
+  YGFreeTreeTask* task = new YGFreeTreeTask{root, cleanup};
+  if (dispatcher != nullptr) {
+    dispatcher->dispatch(YGFreeTree, task, dispatcher->context);
+  } else {
+    std::thread(YGFreeTree, task, 0).detach();
+  }
+}
+
 void YGNodeReset(YGNodeRef node) {
   node->reset();
 }
@@ -360,7 +430,7 @@ void YGConfigFree(const YGConfigRef config) {
 }
 
 void YGConfigCopy(const YGConfigRef dest, const YGConfigRef src) {
-  memcpy(dest, src, sizeof(YGConfig));
+  *dest = *src;
 }
 
 void YGNodeSetIsReferenceBaseline(YGNodeRef node, bool isReferenceBaseline) {
@@ -439,7 +509,7 @@ void YGNodeRemoveAllChildren(const YGNodeRef owner) {
 
 static void YGNodeSetChildrenInternal(
     YGNodeRef const owner,
-    const std::vector<YGNodeRef>& children) {
+    const YGVector& children) {
   if (!owner) {
     return;
   }
@@ -476,14 +546,228 @@ void YGNodeSetChildren(
     YGNodeRef const owner,
     const YGNodeRef c[],
     const uint32_t count) {
-  const YGVector children = {c, c + count};
-  YGNodeSetChildrenInternal(owner, children);
+  YGNodeSetChildrenInternal(owner, YGVector(c, c + count));
 }
 
 void YGNodeSetChildren(
     YGNodeRef const owner,
     const std::vector<YGNodeRef>& children) {
-  YGNodeSetChildrenInternal(owner, children);
+  YGNodeSetChildrenInternal(owner, YGVector(children.begin(), children.end()));
+}
+
+YGNodeRef YGTreeBuild(
+    const YGConfigRef config,
+    const uint32_t count,
+    const int32_t parentIndex[],
+    const YGNodeRef styleTemplates[],
+    const YGMeasureFunc measureFuncs[],
+    YGNodeRef nodesOut[]) {
+  YGAssertWithConfig(
+      config, count > 0, "YGTreeBuild needs at least one node to build");
+  if (count == 0) {
+    return nullptr;
+  }
+  YGAssertWithConfig(
+      config, parentIndex[0] < 0, "The first node of YGTreeBuild is the root");
+
+  // First pass: validate the parent table and count children so that every
+  // child list is allocated exactly once.
+  std::vector<uint32_t> childCounts(count, 0);
+  for (uint32_t i = 1; i < count; i++) {
+    YGAssertWithConfig(
+        config,
+        parentIndex[i] >= 0 && static_cast<uint32_t>(parentIndex[i]) < i,
+        "YGTreeBuild requires every parent to be listed before its children");
+    childCounts[parentIndex[i]]++;
+  }
+
+  std::vector<YGNodeRef> nodes;
+  if (nodesOut == nullptr) {
+    nodes.resize(count);
+    nodesOut = nodes.data();
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    const YGNodeRef node = YGNodeNewWithConfig(config);
+    if (styleTemplates != nullptr && styleTemplates[i] != nullptr) {
+      node->setStyle(styleTemplates[i]->getStyle());
+    }
+    if (measureFuncs != nullptr && measureFuncs[i] != nullptr) {
+      YGAssertWithNode(
+          node,
+          childCounts[i] == 0,
+          "Cannot set measure function: Nodes with measure functions cannot "
+          "have children.");
+      node->setMeasureFunc(measureFuncs[i]);
+    }
+    node->reserveChildren(childCounts[i]);
+    nodesOut[i] = node;
+  }
+
+  // Second pass: link children in index order. The nodes are fresh, so none of
+  // the ownership checks or per-insertion dirty propagation of
+  // YGNodeInsertChild are needed.
+  for (uint32_t i = 1; i < count; i++) {
+    const YGNodeRef owner = nodesOut[parentIndex[i]];
+    owner->insertChild(
+        nodesOut[i], static_cast<uint32_t>(owner->getChildren().size()));
+    nodesOut[i]->setOwner(owner);
+  }
+
+  const YGNodeRef root = nodesOut[0];
+  root->markDirtyAndPropogate();
+  return root;
+}
+
+struct YGNodePool {
+  // Chunks hold 1 << kChunkBits nodes each and are never moved, so pooled
+  // nodes keep their address. The handle is the index of the node in
+  // allocation order.
+  static constexpr uint32_t kChunkBits = 10;
+  static constexpr uint32_t kChunkSize = 1 << kChunkBits;
+
+  const YGConfigRef config;
+  std::vector<YGNode*> chunks;
+  uint32_t count = 0;
+
+  explicit YGNodePool(YGConfigRef config) : config(config) {}
+
+  YGNode* nodeAt(uint32_t handle) const {
+    return &chunks[handle >> kChunkBits][handle & (kChunkSize - 1)];
+  }
+
+  // Constructs a node from `args` in the next free slot.
+  template <typename... Args>
+  YGNode* emplace(Args&&... args) {
+    YGAssertWithConfig(
+        config,
+        count < YGNodeHandleUndefined,
+        "YGNodePool cannot hold any more nodes");
+    if ((count & (kChunkSize - 1)) == 0) {
+      chunks.push_back(
+          static_cast<YGNode*>(::operator new(sizeof(YGNode) * kChunkSize)));
+      YGConfig::Stats::add(
+          config->stats.bytesAllocated, sizeof(YGNode) * kChunkSize);
+    }
+    const YGNodeHandle handle = count++;
+    YGNode* node = new (nodeAt(handle)) YGNode(std::forward<Args>(args)...);
+    gNodeInstanceCount++;
+    node->setPoolHandle(handle);
+    return node;
+  }
+
+  ~YGNodePool() {
+    for (uint32_t i = 0; i < count; i++) {
+      nodeAt(i)->~YGNode();
+    }
+    for (YGNode* chunk : chunks) {
+      ::operator delete(chunk);
+    }
+    gNodeInstanceCount -= count;
+  }
+};
+
+YGNodePoolRef YGNodePoolNew(const YGConfigRef config) {
+  return new YGNodePool(config);
+}
+
+void YGNodePoolFree(const YGNodePoolRef pool) {
+  delete pool;
+}
+
+YGNodeRef YGNodePoolNewNode(const YGNodePoolRef pool) {
+  const YGNodeRef node = pool->emplace();
+  if (pool->config->useWebDefaults) {
+    node->setStyleFlexDirection(YGFlexDirectionRow);
+    node->setStyleAlignContent(YGAlignStretch);
+  }
+  node->setConfig(pool->config);
+  return node;
+}
+
+uint32_t YGNodePoolGetNodeCount(const YGNodePoolRef pool) {
+  return pool->count;
+}
+
+YGNodeRef YGNodePoolGetNode(
+    const YGNodePoolRef pool,
+    const YGNodeHandle handle) {
+  return handle < pool->count ? pool->nodeAt(handle) : nullptr;
+}
+
+YGNodeHandle YGNodePoolGetHandle(
+    const YGNodePoolRef pool,
+    const YGNodeRef node) {
+  const YGNodeHandle handle = node->getPoolHandle();
+  return YGNodePoolGetNode(pool, handle) == node ? handle
+                                                  : YGNodeHandleUndefined;
+}
+
+uint32_t YGNodePoolGetChildHandles(
+    const YGNodePoolRef pool,
+    const YGNodeRef node,
+    YGNodeHandle handles[]) {
+  uint32_t count = 0;
+  for (const YGNodeRef child : node->getChildren()) {
+    handles[count++] = YGNodePoolGetHandle(pool, child);
+  }
+  return count;
+}
+
+// A copy of a tree, laid out again without the legacy stretch behaviour to
+// find out whether the behaviour made a difference. The nodes live in a pool
+// that is freed at once, and each distinct config of the tree is copied once
+// rather than once per node.
+struct YGLegacyStretchDiffTree {
+  std::vector<std::pair<YGConfigRef, std::unique_ptr<YGConfig>>> configs;
+  YGNodePool pool;
+  const YGNodeRef root;
+
+  explicit YGLegacyStretchDiffTree(const YGNodeRef original)
+      : pool(configFor(original->getConfig())), root(clone(original)) {}
+
+  YGConfigRef configFor(const YGConfigRef config) {
+    if (config == nullptr) {
+      return nullptr;
+    }
+    for (const auto& copied : configs) {
+      if (copied.first == config) {
+        return copied.second.get();
+      }
+    }
+    const YGConfigRef copy = new YGConfig(*config);
+    copy->useLegacyStretchBehaviour = false;
+    // Layouts computed here must not end up in the cache of the real tree.
+    copy->layoutCache = nullptr;
+    configs.emplace_back(config, std::unique_ptr<YGConfig>(copy));
+    return copy;
+  }
+
+  YGNodeRef clone(const YGNodeRef original) {
+    const YGNodeRef node = pool.emplace(*original);
+    node->setOwner(nullptr);
+    node->setConfig(configFor(original->getConfig()));
+    YGVector children;
+    children.reserve(original->getChildren().size());
+    for (const YGNodeRef child : original->getChildren()) {
+      const YGNodeRef childNode = clone(child);
+      childNode->setOwner(node);
+      children.push_back(childNode);
+    }
+    node->setChildren(std::move(children));
+    return node;
+  }
+};
+
+// Whether this layout is one of those sampled for the legacy stretch diff.
+static bool YGConfigSampleLegacyStretchDiff(const YGConfigRef config) {
+  if (config->legacyStretchDiffCountdown > 0) {
+    config->legacyStretchDiffCountdown--;
+    return false;
+  }
+  config->legacyStretchDiffCountdown =
+      config->legacyStretchDiffSamplingRate - 1;
+  return true;
 }
 
 YGNodeRef YGNodeGetChild(const YGNodeRef node, const uint32_t index) {
@@ -518,10 +802,26 @@ void YGNodeMarkDirty(const YGNodeRef node) {
 void YGNodeCopyStyle(const YGNodeRef dstNode, const YGNodeRef srcNode) {
   if (!(dstNode->getStyle() == srcNode->getStyle())) {
     dstNode->setStyle(srcNode->getStyle());
-    dstNode->markDirtyAndPropogate();
+    dstNode->markStyleDirtyAndPropogate();
   }
 }
 
+void YGNodeStyleBeginBatch(const YGNodeRef node) {
+  YGAssertWithNode(
+      node,
+      !node->isStyleBatchOpen(),
+      "A style batch is already open on this node");
+  node->beginStyleBatch();
+}
+
+bool YGNodeStyleCommit(const YGNodeRef node) {
+  YGAssertWithNode(
+      node,
+      node->isStyleBatchOpen(),
+      "YGNodeStyleCommit called without YGNodeStyleBeginBatch");
+  return node->commitStyleBatch();
+}
+
 float YGNodeStyleGetFlexGrow(const YGNodeRef node) {
   return node->getStyle().flexGrow.isUndefined()
       ? kDefaultFlexGrow
@@ -570,7 +870,7 @@ struct DimensionProp {
     auto value = Value::create<U>(newValue);
     if ((node->getStyle().*P)[idx] != value) {
       (node->getStyle().*P)[idx] = value;
-      node->markDirtyAndPropogate();
+      node->markStyleDirtyAndPropogate();
     }
   }
 };
@@ -583,7 +883,7 @@ struct DimensionProp {
     auto value = detail::CompactValue::ofMaybe<YGUnitPoint>(paramName);    \
     if (node->getStyle().instanceName != value) {                          \
       node->getStyle().instanceName = value;                               \
-      node->markDirtyAndPropogate();                                       \
+      node->markStyleDirtyAndPropogate();                                  \
     }                                                                      \
   }                                                                        \
                                                                            \
@@ -592,14 +892,14 @@ struct DimensionProp {
     auto value = detail::CompactValue::ofMaybe<YGUnitPercent>(paramName);  \
     if (node->getStyle().instanceName != value) {                          \
       node->getStyle().instanceName = value;                               \
-      node->markDirtyAndPropogate();                                       \
+      node->markStyleDirtyAndPropogate();                                  \
     }                                                                      \
   }                                                                        \
                                                                            \
   void YGNodeStyleSet##name##Auto(const YGNodeRef node) {                  \
     if (node->getStyle().instanceName != detail::CompactValue::ofAuto()) { \
       node->getStyle().instanceName = detail::CompactValue::ofAuto();      \
-      node->markDirtyAndPropogate();                                       \
+      node->markStyleDirtyAndPropogate();                                  \
     }                                                                      \
   }
 
@@ -621,7 +921,7 @@ struct DimensionProp {
     if (node->getStyle().instanceName[edge] !=                               \
         detail::CompactValue::ofAuto()) {                                    \
       node->getStyle().instanceName[edge] = detail::CompactValue::ofAuto();  \
-      node->markDirtyAndPropogate();                                         \
+      node->markStyleDirtyAndPropogate();                                    \
     }                                                                        \
   }
 
@@ -632,7 +932,7 @@ struct DimensionProp {
     auto value = detail::CompactValue::ofMaybe<YGUnitPoint>(paramName);   \
     if (node->getStyle().instanceName[edge] != value) {                   \
       node->getStyle().instanceName[edge] = value;                        \
-      node->markDirtyAndPropogate();                                      \
+      node->markStyleDirtyAndPropogate();                                 \
     }                                                                     \
   }                                                                       \
                                                                           \
@@ -641,7 +941,7 @@ struct DimensionProp {
     auto value = detail::CompactValue::ofMaybe<YGUnitPercent>(paramName); \
     if (node->getStyle().instanceName[edge] != value) {                   \
       node->getStyle().instanceName[edge] = value;                        \
-      node->markDirtyAndPropogate();                                      \
+      node->markStyleDirtyAndPropogate();                                 \
     }                                                                     \
   }                                                                       \
                                                                           \
@@ -653,9 +953,34 @@ struct DimensionProp {
     return value;                                                         \
   }
 
+// Generation of the latest pass that zeroed a display: none node. A node laid
+// out by a later pass cannot be inside a zeroed subtree, so reading its layout
+// does not need to look at its ancestors.
+static std::atomic<uint32_t> gLayoutZeroedGeneration(0);
+
+// The layout of a node as seen from outside: nodes inside the subtree of a
+// zeroed node (see YGZeroOutLayout) read as zero.
+static const YGLayout& YGNodeGetVisibleLayout(const YGNodeRef node) {
+  static const YGLayout zeroedLayout = [] {
+    YGLayout layout;
+    layout.dimensions = {{0, 0}};
+    return layout;
+  }();
+  if (node->getLayout().generationCount > gLayoutZeroedGeneration) {
+    return node->getLayout();
+  }
+  for (YGNodeRef owner = node->getOwner(); owner != nullptr;
+       owner = owner->getOwner()) {
+    if (owner->isLayoutZeroed()) {
+      return zeroedLayout;
+    }
+  }
+  return node->getLayout();
+}
+
 #define YG_NODE_LAYOUT_PROPERTY_IMPL(type, name, instanceName) \
   type YGNodeLayoutGet##name(const YGNodeRef node) {           \
-    return node->getLayout().instanceName;                     \
+    return YGNodeGetVisibleLayout(node).instanceName;          \
   }
 
 #define YG_NODE_LAYOUT_RESOLVED_PROPERTY_IMPL(type, name, instanceName) \
@@ -665,29 +990,30 @@ struct DimensionProp {
         edge <= YGEdgeEnd,                                              \
         "Cannot get layout properties of multi-edge shorthands");       \
                                                                         \
+    const YGLayout& layout = YGNodeGetVisibleLayout(node);              \
     if (edge == YGEdgeLeft) {                                           \
-      if (node->getLayout().direction == YGDirectionRTL) {              \
-        return node->getLayout().instanceName[YGEdgeEnd];               \
+      if (layout.direction == YGDirectionRTL) {                         \
+        return layout.instanceName[YGEdgeEnd];                          \
       } else {                                                          \
-        return node->getLayout().instanceName[YGEdgeStart];             \
+        return layout.instanceName[YGEdgeStart];                        \
       }                                                                 \
     }                                                                   \
                                                                         \
     if (edge == YGEdgeRight) {                                          \
-      if (node->getLayout().direction == YGDirectionRTL) {              \
-        return node->getLayout().instanceName[YGEdgeStart];             \
+      if (layout.direction == YGDirectionRTL) {                         \
+        return layout.instanceName[YGEdgeStart];                        \
       } else {                                                          \
-        return node->getLayout().instanceName[YGEdgeEnd];               \
+        return layout.instanceName[YGEdgeEnd];                          \
       }                                                                 \
     }                                                                   \
                                                                         \
-    return node->getLayout().instanceName[edge];                        \
+    return layout.instanceName[edge];                                   \
   }
 
 #define YG_NODE_STYLE_SET(node, property, value) \
   if (node->getStyle().property != value) {      \
     node->getStyle().property = value;           \
-    node->markDirtyAndPropogate();               \
+    node->markStyleDirtyAndPropogate();          \
   }
 
 void YGNodeStyleSetDirection(const YGNodeRef node, const YGDirection value) {
@@ -773,7 +1099,7 @@ void YGNodeStyleSetFlex(const YGNodeRef node, const float flex) {
   if (node->getStyle().flex != flex) {
     node->getStyle().flex =
         YGFloatIsUndefined(flex) ? YGFloatOptional() : YGFloatOptional(flex);
-    node->markDirtyAndPropogate();
+    node->markStyleDirtyAndPropogate();
   }
 }
 
@@ -789,7 +1115,7 @@ void YGNodeStyleSetFlexGrow(const YGNodeRef node, const float flexGrow) {
     node->getStyle().flexGrow = YGFloatIsUndefined(flexGrow)
         ? YGFloatOptional()
         : YGFloatOptional(flexGrow);
-    node->markDirtyAndPropogate();
+    node->markStyleDirtyAndPropogate();
   }
 }
 
@@ -799,7 +1125,7 @@ void YGNodeStyleSetFlexShrink(const YGNodeRef node, const float flexShrink) {
     node->getStyle().flexShrink = YGFloatIsUndefined(flexShrink)
         ? YGFloatOptional()
         : YGFloatOptional(flexShrink);
-    node->markDirtyAndPropogate();
+    node->markStyleDirtyAndPropogate();
   }
 }
 
@@ -816,7 +1142,7 @@ void YGNodeStyleSetFlexBasis(const YGNodeRef node, const float flexBasis) {
   auto value = detail::CompactValue::ofMaybe<YGUnitPoint>(flexBasis);
   if (node->getStyle().flexBasis != value) {
     node->getStyle().flexBasis = value;
-    node->markDirtyAndPropogate();
+    node->markStyleDirtyAndPropogate();
   }
 }
 
@@ -826,14 +1152,14 @@ void YGNodeStyleSetFlexBasisPercent(
   auto value = detail::CompactValue::ofMaybe<YGUnitPercent>(flexBasisPercent);
   if (node->getStyle().flexBasis != value) {
     node->getStyle().flexBasis = value;
-    node->markDirtyAndPropogate();
+    node->markStyleDirtyAndPropogate();
   }
 }
 
 void YGNodeStyleSetFlexBasisAuto(const YGNodeRef node) {
   if (node->getStyle().flexBasis != detail::CompactValue::ofAuto()) {
     node->getStyle().flexBasis = detail::CompactValue::ofAuto();
-    node->markDirtyAndPropogate();
+    node->markStyleDirtyAndPropogate();
   }
 }
 
@@ -850,7 +1176,7 @@ void YGNodeStyleSetBorder(
   auto value = detail::CompactValue::ofMaybe<YGUnitPoint>(border);
   if (node->getStyle().border[edge] != value) {
     node->getStyle().border[edge] = value;
-    node->markDirtyAndPropogate();
+    node->markStyleDirtyAndPropogate();
   }
 }
 
@@ -878,7 +1204,7 @@ float YGNodeStyleGetAspectRatio(const YGNodeRef node) {
 void YGNodeStyleSetAspectRatio(const YGNodeRef node, const float aspectRatio) {
   if (node->getStyle().aspectRatio != aspectRatio) {
     node->getStyle().aspectRatio = YGFloatOptional(aspectRatio);
-    node->markDirtyAndPropogate();
+    node->markStyleDirtyAndPropogate();
   }
 }
 
@@ -953,18 +1279,156 @@ YG_NODE_LAYOUT_PROPERTY_IMPL(float, Width, dimensions[YGDimensionWidth]);
 YG_NODE_LAYOUT_PROPERTY_IMPL(float, Height, dimensions[YGDimensionHeight]);
 YG_NODE_LAYOUT_PROPERTY_IMPL(YGDirection, Direction, direction);
 YG_NODE_LAYOUT_PROPERTY_IMPL(bool, HadOverflow, hadOverflow);
+YG_NODE_LAYOUT_PROPERTY_IMPL(bool, IsVirtualized, isVirtualized);
 
 YG_NODE_LAYOUT_RESOLVED_PROPERTY_IMPL(float, Margin, margin);
 YG_NODE_LAYOUT_RESOLVED_PROPERTY_IMPL(float, Border, border);
 YG_NODE_LAYOUT_RESOLVED_PROPERTY_IMPL(float, Padding, padding);
 
 bool YGNodeLayoutGetDidLegacyStretchFlagAffectLayout(const YGNodeRef node) {
-  return node->getLayout().doesLegacyStretchFlagAffectsLayout;
+  return YGNodeGetVisibleLayout(node).doesLegacyStretchFlagAffectsLayout;
+}
+
+// Every layout pass takes a new generation, which tells nodes laid out during
+// the pass apart from those laid out by earlier ones.
+std::atomic<uint32_t> gCurrentGenerationCount(0);
+
+namespace {
+
+struct LayoutBudget;
+
+// Subtrees laid out or measured in a pass, by structural hash and
+// constraints, for YGConfigSetMemoizeIdenticalSubtrees.
+struct LayoutMemo {
+  template <typename T>
+  using Map =
+      std::unordered_map<YGLayoutCache::Key, T, YGLayoutCache::KeyHasher>;
+
+  Map<YGNodeRef> layouts;
+  Map<std::array<float, 2>> measurements;
+};
+
+// State of a single layout pass. It is threaded through the recursive layout
+// functions instead of living in globals, so that independent trees can be
+// laid out concurrently.
+struct LayoutData : YGMarkerLayoutData {
+  const uint32_t generationCount;
+  uint32_t depth = 0;
+  // Only reported through YGConfigGetStats.
+  uint32_t measureCalls = 0;
+  uint32_t cacheEvictions = 0;
+  // Only set for time-sliced passes (YGLayoutTask).
+  LayoutBudget* budget = nullptr;
+  // Allocated on first use.
+  std::unique_ptr<LayoutMemo> memo;
+
+  explicit LayoutData(uint32_t generationCount)
+      : YGMarkerLayoutData(), generationCount(generationCount) {}
+};
+
+// Thrown out of a time-sliced pass once its budget is spent.
+struct LayoutInterrupted {};
+
+struct LayoutBudget {
+  using Clock = std::chrono::steady_clock;
+
+  uint32_t remainingNodes;
+  bool hasDeadline;
+  Clock::time_point deadline;
+  // Number of nodes whose layout finished in this slice. A slice is never
+  // interrupted before one node has finished, so every slice makes progress.
+  uint32_t completedNodes = 0;
+
+  // Called before a node is laid out or measured (cache hits are free).
+  void spend() {
+    if (completedNodes > 0 &&
+        (remainingNodes == 0 || (hasDeadline && Clock::now() >= deadline))) {
+      throw LayoutInterrupted();
+    }
+    if (remainingNodes > 0) {
+      remainingNodes--;
+    }
+  }
+};
+
+// Adds the counters and duration of a pass to the stats of the root's config
+// when the pass ends, including a YGLayoutTask slice that is interrupted.
+struct LayoutStatsScope {
+  using Clock = std::chrono::steady_clock;
+
+  YGConfig::Stats& stats;
+  const LayoutData& data;
+  const Clock::time_point start = Clock::now();
+
+  LayoutStatsScope(YGConfig::Stats& stats, const LayoutData& data)
+      : stats(stats), data(data) {}
+
+  ~LayoutStatsScope() {
+    const uint64_t hits = data.cachedLayouts + data.cachedMeasures;
+    const uint64_t misses = data.layouts + data.measures;
+    YGConfig::Stats::add(stats.layoutPasses, 1);
+    YGConfig::Stats::add(stats.nodesVisited, hits + misses);
+    YGConfig::Stats::add(stats.measureCalls, data.measureCalls);
+    YGConfig::Stats::add(stats.cacheHits, hits);
+    YGConfig::Stats::add(stats.cacheMisses, misses);
+    YGConfig::Stats::add(stats.cacheEvictions, data.cacheEvictions);
+    YGConfig::Stats::add(
+        stats.layoutTimeNs,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - start)
+            .count());
+  }
+};
+
+// Why YGLayoutNodeInternal was called, as printed by the gPrintChanges trace.
+enum class LayoutPassReason {
+  kInitial,
+  kAbsLayout,
+  kStretch,
+  kMultilineStretch,
+  kFlexLayout,
+  kMeasureChild,
+  kAbsMeasureChild,
+  kFlexMeasure,
+};
+
+const char* LayoutPassReasonToString(const LayoutPassReason reason) {
+  switch (reason) {
+    case LayoutPassReason::kInitial:
+      return "initial";
+    case LayoutPassReason::kAbsLayout:
+      return "abs-layout";
+    case LayoutPassReason::kStretch:
+      return "stretch";
+    case LayoutPassReason::kMultilineStretch:
+      return "multiline-stretch";
+    case LayoutPassReason::kFlexLayout:
+      return "flex";
+    case LayoutPassReason::kMeasureChild:
+      return "measure";
+    case LayoutPassReason::kAbsMeasureChild:
+      return "abs-measure";
+    case LayoutPassReason::kFlexMeasure:
+      return "flex";
+  }
+  return "";
 }
 
-uint32_t gCurrentGenerationCount = 0;
+} // namespace
+
+// Checks made by the layout algorithm on its own state and on the results of
+// callbacks, as opposed to checks on how the API is used. Builds that define
+// YG_DISABLE_DEBUG_CHECKS (the yoga-fast target) compile them out.
+static inline void YGDebugAssertWithNode(
+    const YGNodeRef node,
+    const bool condition,
+    const char* message) {
+#ifndef YG_DISABLE_DEBUG_CHECKS
+  YGAssertWithNode(node, condition, message);
+#endif
+}
 
-bool YGLayoutNodeInternal(
+static bool YGLayoutNodeInternal(
     const YGNodeRef node,
     const float availableWidth,
     const float availableHeight,
@@ -974,9 +1438,9 @@ bool YGLayoutNodeInternal(
     const float ownerWidth,
     const float ownerHeight,
     const bool performLayout,
-    const char* reason,
+    const LayoutPassReason reason,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    LayoutData& layoutMarkerData,
     void* const layoutContext);
 
 #ifdef DEBUG
@@ -1030,7 +1494,9 @@ static inline YGAlign YGNodeAlignItem(
   return align;
 }
 
-static float YGBaseline(const YGNodeRef node, void* layoutContext) {
+static float YGBaseline(const YGNodeRef node, void* layoutContext);
+
+static float YGComputeBaseline(const YGNodeRef node, void* layoutContext) {
   if (node->hasBaselineFunc()) {
     const float baseline = marker::MarkerSection<YGMarkerBaselineFn>::wrap(
         node,
@@ -1038,12 +1504,15 @@ static float YGBaseline(const YGNodeRef node, void* layoutContext) {
         node->getLayout().measuredDimensions[YGDimensionWidth],
         node->getLayout().measuredDimensions[YGDimensionHeight],
         layoutContext);
-    YGAssertWithNode(
+    YGDebugAssertWithNode(
         node,
         !YGFloatIsUndefined(baseline),
         "Expect custom baseline function to not return NaN");
     return baseline;
   }
+  if (node->isLayoutZeroed()) {
+    return node->getLayout().measuredDimensions[YGDimensionHeight];
+  }
 
   YGNodeRef baselineChild = nullptr;
   const uint32_t childCount = YGNodeGetChildCount(node);
@@ -1074,23 +1543,15 @@ static float YGBaseline(const YGNodeRef node, void* layoutContext) {
   return baseline + baselineChild->getLayout().position[YGEdgeTop];
 }
 
-static bool YGIsBaselineLayout(const YGNodeRef node) {
-  if (YGFlexDirectionIsColumn(node->getStyle().flexDirection)) {
-    return false;
-  }
-  if (node->getStyle().alignItems == YGAlignBaseline) {
-    return true;
-  }
-  const uint32_t childCount = YGNodeGetChildCount(node);
-  for (uint32_t i = 0; i < childCount; i++) {
-    const YGNodeRef child = YGNodeGetChild(node, i);
-    if (child->getStyle().positionType == YGPositionTypeRelative &&
-        child->getStyle().alignSelf == YGAlignBaseline) {
-      return true;
-    }
+// Baselines are asked for by every line and every baseline-aligned sibling,
+// and each one descends into the first child of the node's first line, so the
+// result is kept until the node is laid out again.
+static float YGBaseline(const YGNodeRef node, void* layoutContext) {
+  YGLayout& layout = node->getLayout();
+  if (YGFloatIsUndefined(layout.baseline)) {
+    layout.baseline = YGComputeBaseline(node, layoutContext);
   }
-
-  return false;
+  return layout.baseline;
 }
 
 static inline float YGNodeDimWithMargin(
@@ -1221,7 +1682,7 @@ static void YGNodeComputeFlexBasisForChild(
     const YGMeasureMode heightMode,
     const YGDirection direction,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    LayoutData& layoutMarkerData,
     void* const layoutContext) {
   const YGFlexDirection mainAxis =
       YGResolveFlexDirection(node->getStyle().flexDirection, direction);
@@ -1246,7 +1707,7 @@ static void YGNodeComputeFlexBasisForChild(
         (YGConfigIsExperimentalFeatureEnabled(
              child->getConfig(), YGExperimentalFeatureWebFlexBasis) &&
          child->getLayout().computedFlexBasisGeneration !=
-             gCurrentGenerationCount)) {
+             layoutMarkerData.generationCount)) {
       const YGFloatOptional paddingAndBorder = YGFloatOptional(
           YGNodePaddingAndBorderForAxis(child, mainAxis, ownerWidth));
       child->setLayoutComputedFlexBasis(
@@ -1394,7 +1855,7 @@ static void YGNodeComputeFlexBasisForChild(
         ownerWidth,
         ownerHeight,
         false,
-        "measure",
+        LayoutPassReason::kMeasureChild,
         config,
         layoutMarkerData,
         layoutContext);
@@ -1403,24 +1864,31 @@ static void YGNodeComputeFlexBasisForChild(
         child->getLayout().measuredDimensions[dim[mainAxis]],
         YGNodePaddingAndBorderForAxis(child, mainAxis, ownerWidth))));
   }
-  child->setLayoutComputedFlexBasisGeneration(gCurrentGenerationCount);
+  child->setLayoutComputedFlexBasisGeneration(
+      layoutMarkerData.generationCount);
 }
 
-static void YGNodeAbsoluteLayoutChild(
+static bool YGAbsoluteLayoutInputsEqual(
+    const YGAbsoluteLayoutInputs& a,
+    const YGAbsoluteLayoutInputs& b) {
+  return YGFloatArrayEqual(a.ownerSizes, b.ownerSizes) &&
+      a.widthMeasureMode == b.widthMeasureMode &&
+      a.direction == b.direction && a.isMainAxisRow == b.isMainAxisRow;
+}
+
+// Sizes and lays out an absolute child, measuring it first if its style and
+// offsets leave a dimension open.
+static void YGAbsoluteLayoutChildSize(
     const YGNodeRef node,
     const YGNodeRef child,
     const float width,
     const YGMeasureMode widthMode,
     const float height,
     const YGDirection direction,
+    const bool isMainAxisRow,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    LayoutData& layoutMarkerData,
     void* const layoutContext) {
-  const YGFlexDirection mainAxis =
-      YGResolveFlexDirection(node->getStyle().flexDirection, direction);
-  const YGFlexDirection crossAxis = YGFlexDirectionCross(mainAxis, direction);
-  const bool isMainAxisRow = YGFlexDirectionIsRow(mainAxis);
-
   float childWidth = YGUndefined;
   float childHeight = YGUndefined;
   YGMeasureMode childWidthMeasureMode = YGMeasureModeUndefined;
@@ -1518,7 +1986,7 @@ static void YGNodeAbsoluteLayoutChild(
         childWidth,
         childHeight,
         false,
-        "abs-measure",
+        LayoutPassReason::kAbsMeasureChild,
         config,
         layoutMarkerData,
         layoutContext);
@@ -1538,10 +2006,81 @@ static void YGNodeAbsoluteLayoutChild(
       childWidth,
       childHeight,
       true,
-      "abs-layout",
+      LayoutPassReason::kAbsLayout,
       config,
       layoutMarkerData,
       layoutContext);
+}
+
+static void YGNodeAbsoluteLayoutChild(
+    const YGNodeRef node,
+    const YGNodeRef child,
+    const float width,
+    const YGMeasureMode widthMode,
+    const float height,
+    const YGDirection direction,
+    const YGConfigRef config,
+    LayoutData& layoutMarkerData,
+    void* const layoutContext) {
+  const YGFlexDirection mainAxis =
+      YGResolveFlexDirection(node->getStyle().flexDirection, direction);
+  const YGFlexDirection crossAxis = YGFlexDirectionCross(mainAxis, direction);
+  const bool isMainAxisRow = YGFlexDirectionIsRow(mainAxis);
+
+  YGAbsoluteLayoutInputs inputs;
+  inputs.ownerSizes = {
+      {width,
+       height,
+       node->getLayout().measuredDimensions[YGDimensionWidth],
+       node->getLayout().measuredDimensions[YGDimensionHeight],
+       node->getLeadingBorder(YGFlexDirectionRow) +
+           node->getTrailingBorder(YGFlexDirectionRow),
+       node->getLeadingBorder(YGFlexDirectionColumn) +
+           node->getTrailingBorder(YGFlexDirectionColumn)}};
+  inputs.widthMeasureMode = widthMode;
+  inputs.direction = direction;
+  inputs.isMainAxisRow = isMainAxisRow;
+
+  // A clean child whose last layout was this one, under the same inputs, is
+  // only positioned. Its layout is restored like a layout cache hit would.
+  YGLayout& childLayout = child->getLayout();
+  const YGAbsoluteLayoutInputs& lastInputs = childLayout.absoluteLayoutInputs;
+  if (!child->isDirty() &&
+      YGAbsoluteLayoutInputsEqual(inputs, lastInputs) &&
+      childLayout.lastOwnerDirection == direction &&
+      childLayout.cachedLayout.widthMeasureMode == YGMeasureModeExactly &&
+      childLayout.cachedLayout.heightMeasureMode == YGMeasureModeExactly &&
+      YGFloatsEqual(
+          childLayout.cachedLayout.availableWidth, lastInputs.childSize[0]) &&
+      YGFloatsEqual(
+          childLayout.cachedLayout.availableHeight, lastInputs.childSize[1])) {
+    childLayout.measuredDimensions[YGDimensionWidth] =
+        childLayout.cachedLayout.computedWidth;
+    childLayout.measuredDimensions[YGDimensionHeight] =
+        childLayout.cachedLayout.computedHeight;
+    child->setLayoutDimension(
+        childLayout.cachedLayout.computedWidth, YGDimensionWidth);
+    child->setLayoutDimension(
+        childLayout.cachedLayout.computedHeight, YGDimensionHeight);
+    child->setHasNewLayout(true);
+    childLayout.generationCount = layoutMarkerData.generationCount;
+    layoutMarkerData.skippedAbsoluteLayouts += 1;
+  } else {
+    YGAbsoluteLayoutChildSize(
+        node,
+        child,
+        width,
+        widthMode,
+        height,
+        direction,
+        isMainAxisRow,
+        config,
+        layoutMarkerData,
+        layoutContext);
+    inputs.childSize = {{childLayout.cachedLayout.availableWidth,
+                         childLayout.cachedLayout.availableHeight}};
+    childLayout.absoluteLayoutInputs = inputs;
+  }
 
   if (child->isTrailingPosDefined(mainAxis) &&
       !child->isLeadingPositionDefined(mainAxis)) {
@@ -1609,8 +2148,9 @@ static void YGNodeWithMeasureFuncSetMeasuredDimensions(
     const YGMeasureMode heightMeasureMode,
     const float ownerWidth,
     const float ownerHeight,
+    LayoutData& layoutMarkerData,
     void* const layoutContext) {
-  YGAssertWithNode(
+  YGDebugAssertWithNode(
       node,
       node->hasMeasureFunc(),
       "Expected node to have custom measure function");
@@ -1654,6 +2194,7 @@ static void YGNodeWithMeasureFuncSetMeasuredDimensions(
         YGDimensionHeight);
   } else {
     // Measure the text under the current constraints.
+    layoutMarkerData.measureCalls++;
     const YGSize measuredSize = marker::MarkerSection<YGMarkerMeasure>::wrap(
         node,
         &YGNode::measure,
@@ -1783,16 +2324,35 @@ static bool YGNodeFixedSizeSetMeasuredDimensions(
   return false;
 }
 
-static void YGZeroOutLayoutRecursivly(
+// Zeroing the whole subtree of a hidden node costs as much as laying it out,
+// on every pass that reaches the node. Only the node itself is zeroed, once;
+// its descendants keep their layout and read as zero through
+// YGNodeGetVisibleLayout until the node is shown and laid out again.
+static void YGZeroOutLayout(
     const YGNodeRef node,
-    void* layoutContext) {
+    const uint32_t generationCount) {
+  if (node->isLayoutZeroed()) {
+    return;
+  }
   node->getLayout() = {};
   node->setLayoutDimension(0, 0);
   node->setLayoutDimension(0, 1);
   node->setHasNewLayout(true);
+  node->setLayoutZeroed(true);
+
+  uint32_t zeroedGeneration = gLayoutZeroedGeneration;
+  while (zeroedGeneration < generationCount &&
+         !gLayoutZeroedGeneration.compare_exchange_weak(
+             zeroedGeneration, generationCount)) {
+  }
+}
 
+static void YGMarkSubtreeHasNewLayout(
+    const YGNodeRef node,
+    void* layoutContext) {
+  node->setHasNewLayout(true);
   node->iterChildrenAfterCloningIfNeeded(
-      YGZeroOutLayoutRecursivly, layoutContext);
+      YGMarkSubtreeHasNewLayout, layoutContext);
 }
 
 static float YGNodeCalculateAvailableInnerDim(
@@ -1834,6 +2394,52 @@ static float YGNodeCalculateAvailableInnerDim(
   return availableInnerDim;
 }
 
+static bool YGNodeIsVirtualizing(
+    const YGNodeRef node,
+    const YGFlexDirection mainAxis) {
+  const YGStyle& style = node->getStyle();
+  return !YGFloatIsUndefined(node->getViewport().length) &&
+      style.overflow == YGOverflowScroll && style.flexWrap == YGWrapNoWrap &&
+      style.justifyContent == YGJustifyFlexStart &&
+      mainAxis != YGFlexDirectionRowReverse &&
+      mainAxis != YGFlexDirectionColumnReverse && !node->isBaselineLayout();
+}
+
+// Whether the flex basis of the child can only be found by measuring it.
+static bool YGNodeFlexBasisNeedsMeasure(
+    const YGNodeRef child,
+    const YGFlexDirection mainAxis,
+    const float mainAxisSize) {
+  return (YGResolveValue(child->resolveFlexBasisPtr(), mainAxisSize)
+              .isUndefined() ||
+          YGFloatIsUndefined(mainAxisSize)) &&
+      !YGNodeIsStyleDimDefined(child, mainAxis, mainAxisSize);
+}
+
+// Sizes a child outside its owner's viewport without laying it out. A cross
+// size that isn't known from the owner falls back to the child's last layout.
+static void YGNodeSetVirtualizedSize(
+    const YGNodeRef child,
+    const YGFlexDirection mainAxis,
+    const float mainSize,
+    const YGFlexDirection crossAxis,
+    float crossSize,
+    const bool performLayout) {
+  if (YGFloatIsUndefined(crossSize)) {
+    crossSize = YGNodeIsLayoutDimDefined(child, crossAxis)
+        ? child->getLayout().measuredDimensions[dim[crossAxis]]
+        : 0;
+  }
+  child->setLayoutMeasuredDimension(mainSize, dim[mainAxis]);
+  child->setLayoutMeasuredDimension(crossSize, dim[crossAxis]);
+  child->getLayout().baseline = YGUndefined;
+  if (performLayout) {
+    child->setLayoutDimension(mainSize, dim[mainAxis]);
+    child->setLayoutDimension(crossSize, dim[crossAxis]);
+    child->setHasNewLayout(true);
+  }
+}
+
 static float YGNodeComputeFlexBasisForChildren(
     const YGNodeRef node,
     const float availableInnerWidth,
@@ -1844,11 +2450,11 @@ static float YGNodeComputeFlexBasisForChildren(
     YGFlexDirection mainAxis,
     const YGConfigRef config,
     bool performLayout,
-    YGMarkerLayoutData& layoutMarkerData,
+    LayoutData& layoutMarkerData,
     void* const layoutContext) {
   float totalOuterFlexBasis = 0.0f;
   YGNodeRef singleFlexChild = nullptr;
-  YGVector children = node->getChildren();
+  const YGVector& children = node->getChildren();
   YGMeasureMode measureModeMainDim =
       YGFlexDirectionIsRow(mainAxis) ? widthMeasureMode : heightMeasureMode;
   // If there is only one child with flexGrow + flexShrink it means we can set
@@ -1871,10 +2477,25 @@ static float YGNodeComputeFlexBasisForChildren(
     }
   }
 
+  const bool isVirtualizing = YGNodeIsVirtualizing(node, mainAxis);
+  const float mainAxisSize = YGFlexDirectionIsRow(mainAxis)
+      ? availableInnerWidth
+      : availableInnerHeight;
+  const YGViewport& viewport = node->getViewport();
+  const float windowStart = viewport.offset - viewport.overscan;
+  const float windowEnd = viewport.offset + viewport.length + viewport.overscan;
+  // Leading edge of the next child, valid while children are laid out
+  // sequentially (see YGNodeIsVirtualizing).
+  float mainOffset = isVirtualizing
+      ? node->getLeadingPaddingAndBorder(mainAxis, availableInnerWidth)
+            .unwrap()
+      : 0;
+
   for (auto child : children) {
     child->resolveDimension();
+    child->setLayoutIsVirtualized(false);
     if (child->getStyle().display == YGDisplayNone) {
-      YGZeroOutLayoutRecursivly(child, layoutContext);
+      YGZeroOutLayout(child, layoutMarkerData.generationCount);
       child->setHasNewLayout(true);
       child->setDirty(false);
       continue;
@@ -1895,9 +2516,31 @@ static float YGNodeComputeFlexBasisForChildren(
     if (child->getStyle().positionType == YGPositionTypeAbsolute) {
       continue;
     }
-    if (child == singleFlexChild) {
-      child->setLayoutComputedFlexBasisGeneration(gCurrentGenerationCount);
-      child->setLayoutComputedFlexBasis(YGFloatOptional(0));
+    const bool canVirtualize = isVirtualizing && !child->isNodeFlexible();
+    const float childStart = mainOffset +
+        child->getLeadingMargin(mainAxis, availableInnerWidth).unwrap();
+    bool isEstimated = false;
+    if (canVirtualize &&
+        YGNodeFlexBasisNeedsMeasure(child, mainAxis, mainAxisSize)) {
+      // Measuring is what virtualization saves, so decide with the size of
+      // the child's last layout, or the estimate, whether it is needed.
+      const float estimatedSize = YGNodeIsLayoutDimDefined(child, mainAxis)
+          ? child->getLayout().measuredDimensions[dim[mainAxis]]
+          : viewport.estimatedChildSize;
+      if (childStart + estimatedSize < windowStart || childStart > windowEnd) {
+        child->setLayoutComputedFlexBasisGeneration(
+            layoutMarkerData.generationCount);
+        child->setLayoutComputedFlexBasis(YGFloatOptional(estimatedSize));
+        isEstimated = true;
+      }
+    }
+
+    if (isEstimated) {
+      // Flex basis already set.
+    } else if (child == singleFlexChild) {
+      child->setLayoutComputedFlexBasisGeneration(
+          layoutMarkerData.generationCount);
+      child->setLayoutComputedFlexBasis(YGFloatOptional(0));
     } else {
       YGNodeComputeFlexBasisForChild(
           node,
@@ -1918,6 +2561,20 @@ static float YGNodeComputeFlexBasisForChildren(
         (child->getLayout().computedFlexBasis +
          child->getMarginForAxis(mainAxis, availableInnerWidth))
             .unwrap();
+
+    if (isVirtualizing) {
+      const float childSize = YGNodeBoundAxisWithinMinAndMax(
+                                  child,
+                                  mainAxis,
+                                  child->getLayout().computedFlexBasis,
+                                  mainAxisSize)
+                                  .unwrap();
+      child->setLayoutIsVirtualized(
+          canVirtualize &&
+          (childStart + childSize < windowStart || childStart > windowEnd));
+      mainOffset += childSize +
+          child->getMarginForAxis(mainAxis, availableInnerWidth).unwrap();
+    }
   }
 
   return totalOuterFlexBasis;
@@ -2006,6 +2663,173 @@ static YGCollectFlexItemsRowValues YGCalculateCollectFlexItemsRowValues(
   return flexAlgoRowMeasurement;
 }
 
+static bool YGFlexLineSizesEqual(const float a, const float b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+// STEP 4 for wrapping containers with many children: breaks all lines up
+// front, into node->getFlexLines(), from a contiguous array of the children's
+// outer main sizes. The leading lines of the previous layout that still hold
+// the same children and still break at the same place are kept, and the
+// breaks after them are found with a binary search over prefix sums of the
+// sizes. Each line is then summed in the same order as
+// YGCalculateCollectFlexItemsRowValues does, so the breaks match it exactly.
+//
+// Returns false, leaving the lines empty, for sizes a search cannot handle
+// (negative or undefined), and the caller falls back to collecting each line
+// with YGCalculateCollectFlexItemsRowValues.
+static bool YGNodeCollectFlexLines(
+    const YGNodeRef node,
+    const YGFlexDirection mainAxis,
+    const float mainAxisownerSize,
+    const float availableInnerWidth,
+    const float availableInnerMainDim,
+    LayoutData& layoutMarkerData) {
+  YGFlexLines& flexLines = node->getFlexLines();
+  const uint32_t childCount = YGNodeGetChildCount(node);
+
+  std::vector<float> outerMainSizes(childCount);
+  uint32_t firstChangedIndex =
+      flexLines.outerMainSizes.size() == childCount ? childCount : 0;
+  for (uint32_t i = 0; i < childCount; i++) {
+    const YGNodeRef child = node->getChild(i);
+    float size = YGUndefined;
+    if (child->getStyle().display != YGDisplayNone &&
+        child->getStyle().positionType != YGPositionTypeAbsolute) {
+      size = YGNodeBoundAxisWithinMinAndMax(
+                 child,
+                 mainAxis,
+                 child->getLayout().computedFlexBasis,
+                 mainAxisownerSize)
+                 .unwrap() +
+          child->getMarginForAxis(mainAxis, availableInnerWidth).unwrap();
+      if (!(size >= 0) || std::isinf(size)) {
+        flexLines = {};
+        return false;
+      }
+    }
+    outerMainSizes[i] = size;
+    if (i < firstChangedIndex &&
+        !YGFlexLineSizesEqual(size, flexLines.outerMainSizes[i])) {
+      firstChangedIndex = i;
+    }
+  }
+  flexLines.outerMainSizes.swap(outerMainSizes);
+  const std::vector<float>& sizes = flexLines.outerMainSizes;
+
+  // A line is kept if none of its children, nor the one it broke before,
+  // changed size, and the line still breaks there: with sizes that are not
+  // negative, a line fits if its last item fits.
+  std::vector<YGFlexLine>& lines = flexLines.lines;
+  uint32_t startIndex = 0;
+  size_t lineCount = 0;
+  for (; lineCount < lines.size(); lineCount++) {
+    const YGFlexLine& line = lines[lineCount];
+    const bool isUnchanged = line.endIndex == childCount
+        ? firstChangedIndex == childCount
+        : line.endIndex < firstChangedIndex;
+    if (!isUnchanged ||
+        (line.itemCount > 1 && line.size > availableInnerMainDim) ||
+        (line.endIndex < childCount &&
+         !(line.size + sizes[line.endIndex] > availableInnerMainDim))) {
+      break;
+    }
+    startIndex = line.endIndex;
+  }
+  lines.resize(lineCount);
+  layoutMarkerData.reusedFlexLines += static_cast<int>(lineCount);
+
+  std::vector<double> prefixSums;
+  const bool canSearch = !YGFloatIsUndefined(availableInnerMainDim) &&
+      startIndex < childCount;
+  if (canSearch) {
+    prefixSums.resize(childCount + 1);
+    prefixSums[0] = 0;
+    for (uint32_t i = 0; i < childCount; i++) {
+      prefixSums[i + 1] =
+          prefixSums[i] + (std::isnan(sizes[i]) ? 0 : sizes[i]);
+    }
+  }
+
+  while (startIndex < childCount) {
+    YGFlexLine line = {startIndex, 0, 0};
+    if (canSearch) {
+      // Add up the items the prefix sums say fit without comparing each one,
+      // unless the sum in floats disagrees.
+      const auto guess = std::upper_bound(
+          prefixSums.begin() + startIndex,
+          prefixSums.end(),
+          prefixSums[startIndex] + availableInnerMainDim);
+      const uint32_t guessIndex = guess == prefixSums.begin() + startIndex
+          ? startIndex
+          : static_cast<uint32_t>(guess - prefixSums.begin()) - 1;
+      for (; line.endIndex < guessIndex; line.endIndex++) {
+        if (!std::isnan(sizes[line.endIndex])) {
+          line.size += sizes[line.endIndex];
+          line.itemCount++;
+        }
+      }
+      if (line.itemCount > 1 && line.size > availableInnerMainDim) {
+        line = {startIndex, 0, 0};
+      }
+    }
+    for (; line.endIndex < childCount; line.endIndex++) {
+      const float size = sizes[line.endIndex];
+      if (std::isnan(size)) {
+        continue;
+      }
+      if (line.size + size > availableInnerMainDim && line.itemCount > 0) {
+        break;
+      }
+      line.size += size;
+      line.itemCount++;
+    }
+    lines.push_back(line);
+    startIndex = line.endIndex;
+  }
+  return true;
+}
+
+// YGCalculateCollectFlexItemsRowValues for a line broken by
+// YGNodeCollectFlexLines.
+static YGCollectFlexItemsRowValues YGCollectFlexItemsOfLine(
+    const YGNodeRef node,
+    const uint32_t startOfLineIndex,
+    const uint32_t lineCount) {
+  YGFlexLines& flexLines = node->getFlexLines();
+  const YGFlexLine& line = flexLines.lines[lineCount];
+  YGCollectFlexItemsRowValues flexAlgoRowMeasurement = {};
+  flexAlgoRowMeasurement.relativeChildren.reserve(line.itemCount);
+
+  for (uint32_t i = startOfLineIndex; i < line.endIndex; i++) {
+    if (std::isnan(flexLines.outerMainSizes[i])) {
+      continue;
+    }
+    const YGNodeRef child = node->getChild(i);
+    child->setLineIndex(lineCount);
+    if (child->isNodeFlexible()) {
+      flexAlgoRowMeasurement.totalFlexGrowFactors += child->resolveFlexGrow();
+      flexAlgoRowMeasurement.totalFlexShrinkScaledFactors +=
+          -child->resolveFlexShrink() *
+          child->getLayout().computedFlexBasis.unwrap();
+    }
+    flexAlgoRowMeasurement.relativeChildren.push_back(child);
+  }
+  flexAlgoRowMeasurement.itemsOnLine = line.itemCount;
+  flexAlgoRowMeasurement.sizeConsumedOnCurrentLine = line.size;
+
+  if (flexAlgoRowMeasurement.totalFlexGrowFactors > 0 &&
+      flexAlgoRowMeasurement.totalFlexGrowFactors < 1) {
+    flexAlgoRowMeasurement.totalFlexGrowFactors = 1;
+  }
+  if (flexAlgoRowMeasurement.totalFlexShrinkScaledFactors > 0 &&
+      flexAlgoRowMeasurement.totalFlexShrinkScaledFactors < 1) {
+    flexAlgoRowMeasurement.totalFlexShrinkScaledFactors = 1;
+  }
+  flexAlgoRowMeasurement.endOfLineIndex = line.endIndex;
+  return flexAlgoRowMeasurement;
+}
+
 // It distributes the free space to the flexible items and ensures that the size
 // of the flex items abide the min and max constraints. At the end of this
 // function the child nodes would have proper size. Prior using this function
@@ -2024,7 +2848,7 @@ static float YGDistributeFreeSpaceSecondPass(
     const YGMeasureMode measureModeCrossDim,
     const bool performLayout,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    LayoutData& layoutMarkerData,
     void* const layoutContext) {
   float childFlexBasis = 0;
   float flexShrinkScaledFactor = 0;
@@ -2100,6 +2924,10 @@ static float YGDistributeFreeSpaceSecondPass(
     float childMainSize = updatedMainSize + marginMain;
     YGMeasureMode childCrossMeasureMode;
     YGMeasureMode childMainMeasureMode = YGMeasureModeExactly;
+    // Set when the cross size given to a stretched child is already the final
+    // cross size of its line, so the child can be laid out here rather than
+    // only measured and then laid out again in STEP 7.
+    bool isStretchSizeFinal = false;
 
     if (!currentRelativeChild->getStyle().aspectRatio.isUndefined()) {
       childCrossSize = isMainAxisRow ? (childMainSize - marginMain) /
@@ -2122,6 +2950,9 @@ static float YGDistributeFreeSpaceSecondPass(
             YGUnitAuto) {
       childCrossSize = availableInnerCrossDim;
       childCrossMeasureMode = YGMeasureModeExactly;
+      // Without wrapping there is a single line, which takes the container's
+      // definite cross size.
+      isStretchSizeFinal = !isNodeFlexWrap;
     } else if (!YGNodeIsStyleDimDefined(
                    currentRelativeChild, crossAxis, availableInnerCrossDim)) {
       childCrossSize = availableInnerCrossDim;
@@ -2166,7 +2997,9 @@ static float YGDistributeFreeSpaceSecondPass(
         YGNodeAlignItem(node, currentRelativeChild) == YGAlignStretch &&
         currentRelativeChild->marginLeadingValue(crossAxis).unit !=
             YGUnitAuto &&
-        currentRelativeChild->marginTrailingValue(crossAxis).unit != YGUnitAuto;
+        currentRelativeChild->marginTrailingValue(crossAxis).unit !=
+            YGUnitAuto &&
+        !isStretchSizeFinal;
 
     const float childWidth = isMainAxisRow ? childMainSize : childCrossSize;
     const float childHeight = !isMainAxisRow ? childMainSize : childCrossSize;
@@ -2176,6 +3009,19 @@ static float YGDistributeFreeSpaceSecondPass(
     const YGMeasureMode childHeightMeasureMode =
         !isMainAxisRow ? childMainMeasureMode : childCrossMeasureMode;
 
+    if (currentRelativeChild->getLayout().isVirtualized) {
+      YGNodeSetVirtualizedSize(
+          currentRelativeChild,
+          mainAxis,
+          updatedMainSize,
+          crossAxis,
+          childCrossMeasureMode == YGMeasureModeExactly
+              ? childCrossSize - marginCross
+              : YGUndefined,
+          performLayout && !requiresStretchLayout);
+      continue;
+    }
+
     // Recursively call the layout algorithm for this child with the updated
     // main size.
     YGLayoutNodeInternal(
@@ -2188,7 +3034,9 @@ static float YGDistributeFreeSpaceSecondPass(
         availableInnerWidth,
         availableInnerHeight,
         performLayout && !requiresStretchLayout,
-        "flex",
+        performLayout && !requiresStretchLayout
+            ? LayoutPassReason::kFlexLayout
+            : LayoutPassReason::kFlexMeasure,
         config,
         layoutMarkerData,
         layoutContext);
@@ -2321,7 +3169,7 @@ static void YGResolveFlexibleLength(
     const YGMeasureMode measureModeCrossDim,
     const bool performLayout,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    LayoutData& layoutMarkerData,
     void* const layoutContext) {
   const float originalFreeSpace = collectedFlexItemsValues.remainingFreeSpace;
   // First pass: detect the flex items whose min/max constraints trigger
@@ -2463,7 +3311,7 @@ static void YGJustifyMainAxis(
 
   float maxAscentForCurrentLine = 0;
   float maxDescentForCurrentLine = 0;
-  bool isNodeBaselineLayout = YGIsBaselineLayout(node);
+  bool isNodeBaselineLayout = node->isBaselineLayout();
   for (uint32_t i = startOfLineIndex;
        i < collectedFlexItemsValues.endOfLineIndex;
        i++) {
@@ -2570,6 +3418,300 @@ static void YGJustifyMainAxis(
   }
 }
 
+// Children of a container take the homogeneous path when there are many of
+// them, they all share one style with fixed point dimensions, none of them
+// flexes or has a measure function, and the container needs no per-child
+// alignment. Such children all get the same flex basis and the same size, so
+// STEPs 3 to 7 can work from the first child's values instead of resolving
+// every child. Sums are still accumulated child by child and in the same
+// order, so the results match the general path exactly.
+static bool YGNodeHasHomogeneousChildren(
+    const YGNodeRef node,
+    const YGFlexDirection mainAxis,
+    const YGFlexDirection crossAxis) {
+  const uint32_t childCount = YGNodeGetChildCount(node);
+  if (childCount < 16 ||
+      node->getStyle().justifyContent != YGJustifyFlexStart ||
+      node->isBaselineLayout() || YGNodeIsVirtualizing(node, mainAxis)) {
+    return false;
+  }
+
+  const YGNodeRef first = node->getChild(0);
+  const YGStyle& style = first->getStyle();
+  first->resolveDimension();
+  if (first->hasMeasureFunc() || style.display == YGDisplayNone ||
+      style.positionType != YGPositionTypeRelative ||
+      first->isNodeFlexible() ||
+      first->resolveFlexBasisPtr().unit != YGUnitAuto ||
+      !style.aspectRatio.isUndefined()) {
+    return false;
+  }
+  for (const YGFlexDirection axis : {mainAxis, crossAxis}) {
+    if (first->getResolvedDimension(dim[axis]).unit != YGUnitPoint ||
+        !YGNodeIsStyleDimDefined(first, axis, YGUndefined) ||
+        first->marginLeadingValue(axis).unit == YGUnitAuto ||
+        first->marginTrailingValue(axis).unit == YGUnitAuto) {
+      return false;
+    }
+  }
+  const YGAlign alignItem = YGNodeAlignItem(node, first);
+  if (alignItem != YGAlignFlexStart && alignItem != YGAlignStretch) {
+    return false;
+  }
+
+  for (uint32_t i = 1; i < childCount; i++) {
+    const YGNodeRef child = node->getChild(i);
+    if (child->hasMeasureFunc() || !(child->getStyle() == style)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// STEP 3 for homogeneous children (see YGNodeHasHomogeneousChildren).
+static float YGNodeComputeHomogeneousFlexBasis(
+    const YGNodeRef node,
+    const float availableInnerWidth,
+    const float availableInnerHeight,
+    YGMeasureMode widthMeasureMode,
+    YGMeasureMode heightMeasureMode,
+    YGDirection direction,
+    YGFlexDirection mainAxis,
+    const YGConfigRef config,
+    bool performLayout,
+    LayoutData& layoutMarkerData,
+    void* const layoutContext) {
+  const YGNodeRef first = node->getChild(0);
+  if (performLayout) {
+    // Set the initial position (relative to the owner).
+    const float mainDim = YGFlexDirectionIsRow(mainAxis)
+        ? availableInnerWidth
+        : availableInnerHeight;
+    const float crossDim = YGFlexDirectionIsRow(mainAxis)
+        ? availableInnerHeight
+        : availableInnerWidth;
+    first->setPosition(
+        first->resolveDirection(direction),
+        mainDim,
+        crossDim,
+        availableInnerWidth);
+  }
+  YGNodeComputeFlexBasisForChild(
+      node,
+      first,
+      availableInnerWidth,
+      widthMeasureMode,
+      availableInnerHeight,
+      availableInnerWidth,
+      availableInnerHeight,
+      heightMeasureMode,
+      direction,
+      config,
+      layoutMarkerData,
+      layoutContext);
+
+  const YGLayout& firstLayout = first->getLayout();
+  const float outerFlexBasis =
+      (firstLayout.computedFlexBasis +
+       first->getMarginForAxis(mainAxis, availableInnerWidth))
+          .unwrap();
+
+  float totalOuterFlexBasis = 0.0f;
+  for (auto child : node->getChildren()) {
+    child->resolveDimension();
+    child->setLayoutIsVirtualized(false);
+    if (performLayout) {
+      for (uint32_t i = 0; i < firstLayout.position.size(); i++) {
+        child->setLayoutPosition(firstLayout.position[i], i);
+      }
+    }
+    child->setLayoutComputedFlexBasis(firstLayout.computedFlexBasis);
+    child->setLayoutComputedFlexBasisGeneration(
+        firstLayout.computedFlexBasisGeneration);
+    totalOuterFlexBasis += outerFlexBasis;
+  }
+  return totalOuterFlexBasis;
+}
+
+// STEP 4 for homogeneous children: YGCalculateCollectFlexItemsRowValues
+// without per-child lookups.
+static YGCollectFlexItemsRowValues YGCollectHomogeneousFlexItems(
+    const YGNodeRef node,
+    const YGFlexDirection mainAxis,
+    const float mainAxisownerSize,
+    const float availableInnerWidth,
+    const float availableInnerMainDim,
+    const uint32_t startOfLineIndex,
+    const uint32_t lineCount) {
+  YGCollectFlexItemsRowValues flexAlgoRowMeasurement = {};
+  const YGNodeRef first = node->getChild(startOfLineIndex);
+  const float childMarginMainAxis =
+      first->getMarginForAxis(mainAxis, availableInnerWidth).unwrap();
+  const float flexBasisWithMinAndMaxConstraints =
+      YGNodeBoundAxisWithinMinAndMax(
+          first,
+          mainAxis,
+          first->getLayout().computedFlexBasis,
+          mainAxisownerSize)
+          .unwrap();
+  const bool isNodeFlexWrap = node->getStyle().flexWrap != YGWrapNoWrap;
+  const uint32_t childCount = YGNodeGetChildCount(node);
+
+  float sizeConsumedOnCurrentLine = 0;
+  uint32_t endOfLineIndex = startOfLineIndex;
+  for (; endOfLineIndex < childCount; endOfLineIndex++) {
+    node->getChild(endOfLineIndex)->setLineIndex(lineCount);
+    if (sizeConsumedOnCurrentLine + flexBasisWithMinAndMaxConstraints +
+                childMarginMainAxis >
+            availableInnerMainDim &&
+        isNodeFlexWrap && flexAlgoRowMeasurement.itemsOnLine > 0) {
+      break;
+    }
+    sizeConsumedOnCurrentLine +=
+        flexBasisWithMinAndMaxConstraints + childMarginMainAxis;
+    flexAlgoRowMeasurement.itemsOnLine++;
+  }
+
+  flexAlgoRowMeasurement.sizeConsumedOnCurrentLine = sizeConsumedOnCurrentLine;
+  flexAlgoRowMeasurement.endOfLineIndex = endOfLineIndex;
+  return flexAlgoRowMeasurement;
+}
+
+// STEP 5 for a line of homogeneous children. No child flexes, so each one is
+// laid out at its flex basis, with the constraints YGDistributeFreeSpace-
+// SecondPass would compute. When only measuring, all children measure the
+// same, so only the first one is measured.
+static void YGResolveHomogeneousLength(
+    const YGNodeRef node,
+    const YGCollectFlexItemsRowValues& collectedFlexItemsValues,
+    const uint32_t startOfLineIndex,
+    const YGFlexDirection mainAxis,
+    const YGFlexDirection crossAxis,
+    const float mainAxisownerSize,
+    const float availableInnerMainDim,
+    const float availableInnerCrossDim,
+    const float availableInnerWidth,
+    const float availableInnerHeight,
+    const bool performLayout,
+    const YGConfigRef config,
+    LayoutData& layoutMarkerData,
+    void* const layoutContext) {
+  const YGNodeRef first = node->getChild(startOfLineIndex);
+  const bool isMainAxisRow = YGFlexDirectionIsRow(mainAxis);
+
+  float childMainSize =
+      YGNodeBoundAxisWithinMinAndMax(
+          first, mainAxis, first->getLayout().computedFlexBasis, mainAxisownerSize)
+          .unwrap() +
+      first->getMarginForAxis(mainAxis, availableInnerWidth).unwrap();
+  float childCrossSize =
+      YGResolveValue(
+          first->getResolvedDimension(dim[crossAxis]), availableInnerCrossDim)
+          .unwrap() +
+      first->getMarginForAxis(crossAxis, availableInnerWidth).unwrap();
+  YGMeasureMode childMainMeasureMode = YGMeasureModeExactly;
+  YGMeasureMode childCrossMeasureMode = YGMeasureModeExactly;
+  YGConstrainMaxSizeForMode(
+      first,
+      mainAxis,
+      availableInnerMainDim,
+      availableInnerWidth,
+      &childMainMeasureMode,
+      &childMainSize);
+  YGConstrainMaxSizeForMode(
+      first,
+      crossAxis,
+      availableInnerCrossDim,
+      availableInnerWidth,
+      &childCrossMeasureMode,
+      &childCrossSize);
+
+  const float childWidth = isMainAxisRow ? childMainSize : childCrossSize;
+  const float childHeight = !isMainAxisRow ? childMainSize : childCrossSize;
+  const YGMeasureMode childWidthMeasureMode =
+      isMainAxisRow ? childMainMeasureMode : childCrossMeasureMode;
+  const YGMeasureMode childHeightMeasureMode =
+      !isMainAxisRow ? childMainMeasureMode : childCrossMeasureMode;
+
+  for (uint32_t i = startOfLineIndex;
+       i < collectedFlexItemsValues.endOfLineIndex;
+       i++) {
+    const YGNodeRef child = node->getChild(i);
+    if (performLayout || child == first) {
+      YGLayoutNodeInternal(
+          child,
+          childWidth,
+          childHeight,
+          node->getLayout().direction,
+          childWidthMeasureMode,
+          childHeightMeasureMode,
+          availableInnerWidth,
+          availableInnerHeight,
+          performLayout,
+          performLayout ? LayoutPassReason::kFlexLayout
+                        : LayoutPassReason::kFlexMeasure,
+          config,
+          layoutMarkerData,
+          layoutContext);
+    } else {
+      child->setLayoutMeasuredDimension(
+          first->getLayout().measuredDimensions[YGDimensionWidth],
+          YGDimensionWidth);
+      child->setLayoutMeasuredDimension(
+          first->getLayout().measuredDimensions[YGDimensionHeight],
+          YGDimensionHeight);
+    }
+    node->setLayoutHadOverflow(
+        node->getLayout().hadOverflow | child->getLayout().hadOverflow);
+  }
+}
+
+// STEP 6 for a line of homogeneous children: YGJustifyMainAxis with
+// justify-content flex-start and every child the same outer size.
+static void YGJustifyHomogeneousMainAxis(
+    const YGNodeRef node,
+    YGCollectFlexItemsRowValues& collectedFlexItemsValues,
+    const uint32_t startOfLineIndex,
+    const YGFlexDirection mainAxis,
+    const YGFlexDirection crossAxis,
+    const YGMeasureMode measureModeCrossDim,
+    const float ownerWidth,
+    const float availableInnerCrossDim,
+    const float availableInnerWidth,
+    const bool performLayout) {
+  const YGNodeRef first = node->getChild(startOfLineIndex);
+  const bool canSkipFlex =
+      !performLayout && measureModeCrossDim == YGMeasureModeExactly;
+
+  // If we skipped the flex step, then we can't rely on the measuredDims
+  // because they weren't computed.
+  const float childOuterMainDim = canSkipFlex
+      ? first->getMarginForAxis(mainAxis, availableInnerWidth).unwrap() +
+          first->getLayout().computedFlexBasis.unwrap()
+      : YGNodeDimWithMargin(first, mainAxis, availableInnerWidth);
+
+  float mainDim =
+      node->getLeadingPaddingAndBorder(mainAxis, ownerWidth).unwrap();
+  for (uint32_t i = startOfLineIndex;
+       i < collectedFlexItemsValues.endOfLineIndex;
+       i++) {
+    if (performLayout) {
+      const YGNodeRef child = node->getChild(i);
+      child->setLayoutPosition(
+          child->getLayout().position[pos[mainAxis]] + mainDim,
+          pos[mainAxis]);
+    }
+    mainDim += childOuterMainDim;
+  }
+
+  collectedFlexItemsValues.mainDim = mainDim +
+      node->getTrailingPaddingAndBorder(mainAxis, ownerWidth).unwrap();
+  collectedFlexItemsValues.crossDim = canSkipFlex
+      ? availableInnerCrossDim
+      : YGFloatMax(
+            0, YGNodeDimWithMargin(first, crossAxis, availableInnerWidth));
+}
+
 //
 // This is the main routine that implements a subset of the flexbox layout
 // algorithm described in the W3C CSS documentation:
@@ -2635,6 +3777,25 @@ static void YGJustifyMainAxis(
 //    passes an available size of undefined then it must also pass a measure
 //    mode of YGMeasureModeUndefined in that dimension.
 //
+// YGComputedEdgeValue with a default of zero for each of the four physical
+// edges, indexed by YGEdge, looking at the horizontal, vertical and all edges
+// only once.
+static std::array<detail::CompactValue, 4> YGComputedPhysicalEdgeValues(
+    const YGStyle::Edges& edges) {
+  const detail::CompactValue all = edges[YGEdgeAll].isUndefined()
+      ? detail::CompactValue::ofZero()
+      : edges[YGEdgeAll];
+  const detail::CompactValue horizontal =
+      edges[YGEdgeHorizontal].isUndefined() ? all : edges[YGEdgeHorizontal];
+  const detail::CompactValue vertical =
+      edges[YGEdgeVertical].isUndefined() ? all : edges[YGEdgeVertical];
+  return {{edges[YGEdgeLeft].isUndefined() ? horizontal : edges[YGEdgeLeft],
+           edges[YGEdgeTop].isUndefined() ? vertical : edges[YGEdgeTop],
+           edges[YGEdgeRight].isUndefined() ? horizontal : edges[YGEdgeRight],
+           edges[YGEdgeBottom].isUndefined() ? vertical
+                                             : edges[YGEdgeBottom]}};
+}
+
 static void YGNodelayoutImpl(
     const YGNodeRef node,
     const float availableWidth,
@@ -2646,16 +3807,16 @@ static void YGNodelayoutImpl(
     const float ownerHeight,
     const bool performLayout,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    LayoutData& layoutMarkerData,
     void* const layoutContext) {
-  YGAssertWithNode(
+  YGDebugAssertWithNode(
       node,
       YGFloatIsUndefined(availableWidth)
           ? widthMeasureMode == YGMeasureModeUndefined
           : true,
       "availableWidth is indefinite so widthMeasureMode must be "
       "YGMeasureModeUndefined");
-  YGAssertWithNode(
+  YGDebugAssertWithNode(
       node,
       YGFloatIsUndefined(availableHeight)
           ? heightMeasureMode == YGMeasureModeUndefined
@@ -2674,36 +3835,75 @@ static void YGNodelayoutImpl(
   const YGFlexDirection flexColumnDirection =
       YGResolveFlexDirection(YGFlexDirectionColumn, direction);
 
+  // The same values YGNode::getLeadingMargin and friends resolve, with the
+  // fallbacks of all edges looked up once per style property.
+  const YGStyle& style = node->getStyle();
+  const YGEdge rowLeadingEdge = leading[flexRowDirection];
+  const YGEdge rowTrailingEdge = trailing[flexRowDirection];
+  const YGEdge columnLeadingEdge = leading[flexColumnDirection];
+  const YGEdge columnTrailingEdge = trailing[flexColumnDirection];
+
+  const auto margin = YGComputedPhysicalEdgeValues(style.margin);
   node->setLayoutMargin(
-      node->getLeadingMargin(flexRowDirection, ownerWidth).unwrap(),
+      YGResolveValueMargin(
+          style.margin[YGEdgeStart].isUndefined() ? margin[rowLeadingEdge]
+                                                  : style.margin[YGEdgeStart],
+          ownerWidth)
+          .unwrap(),
       YGEdgeStart);
   node->setLayoutMargin(
-      node->getTrailingMargin(flexRowDirection, ownerWidth).unwrap(),
+      YGResolveValueMargin(
+          style.margin[YGEdgeEnd].isUndefined() ? margin[rowTrailingEdge]
+                                                : style.margin[YGEdgeEnd],
+          ownerWidth)
+          .unwrap(),
       YGEdgeEnd);
   node->setLayoutMargin(
-      node->getLeadingMargin(flexColumnDirection, ownerWidth).unwrap(),
+      YGResolveValueMargin(margin[columnLeadingEdge], ownerWidth).unwrap(),
       YGEdgeTop);
   node->setLayoutMargin(
-      node->getTrailingMargin(flexColumnDirection, ownerWidth).unwrap(),
+      YGResolveValueMargin(margin[columnTrailingEdge], ownerWidth).unwrap(),
       YGEdgeBottom);
 
-  node->setLayoutBorder(node->getLeadingBorder(flexRowDirection), YGEdgeStart);
-  node->setLayoutBorder(node->getTrailingBorder(flexRowDirection), YGEdgeEnd);
-  node->setLayoutBorder(node->getLeadingBorder(flexColumnDirection), YGEdgeTop);
+  // Borders are always in points.
+  const auto border = YGComputedPhysicalEdgeValues(style.border);
+  const float borderStart = style.border[YGEdgeStart].resolve(YGUndefined);
+  const float borderEnd = style.border[YGEdgeEnd].resolve(YGUndefined);
+  node->setLayoutBorder(
+      borderStart >= 0.0f
+          ? borderStart
+          : YGFloatMax(border[rowLeadingEdge].resolve(YGUndefined), 0.0f),
+      YGEdgeStart);
   node->setLayoutBorder(
-      node->getTrailingBorder(flexColumnDirection), YGEdgeBottom);
+      borderEnd >= 0.0f
+          ? borderEnd
+          : YGFloatMax(border[rowTrailingEdge].resolve(YGUndefined), 0.0f),
+      YGEdgeEnd);
+  node->setLayoutBorder(
+      YGFloatMax(border[columnLeadingEdge].resolve(YGUndefined), 0.0f),
+      YGEdgeTop);
+  node->setLayoutBorder(
+      YGFloatMax(border[columnTrailingEdge].resolve(YGUndefined), 0.0f),
+      YGEdgeBottom);
 
+  const auto padding = YGComputedPhysicalEdgeValues(style.padding);
+  const float paddingStart = style.padding[YGEdgeStart].resolve(ownerWidth);
+  const float paddingEnd = style.padding[YGEdgeEnd].resolve(ownerWidth);
   node->setLayoutPadding(
-      node->getLeadingPadding(flexRowDirection, ownerWidth).unwrap(),
+      paddingStart >= 0.0f
+          ? paddingStart
+          : YGFloatMax(padding[rowLeadingEdge].resolve(ownerWidth), 0.0f),
       YGEdgeStart);
   node->setLayoutPadding(
-      node->getTrailingPadding(flexRowDirection, ownerWidth).unwrap(),
+      paddingEnd >= 0.0f
+          ? paddingEnd
+          : YGFloatMax(padding[rowTrailingEdge].resolve(ownerWidth), 0.0f),
       YGEdgeEnd);
   node->setLayoutPadding(
-      node->getLeadingPadding(flexColumnDirection, ownerWidth).unwrap(),
+      YGFloatMax(padding[columnLeadingEdge].resolve(ownerWidth), 0.0f),
       YGEdgeTop);
   node->setLayoutPadding(
-      node->getTrailingPadding(flexColumnDirection, ownerWidth).unwrap(),
+      YGFloatMax(padding[columnTrailingEdge].resolve(ownerWidth), 0.0f),
       YGEdgeBottom);
 
   if (node->hasMeasureFunc()) {
@@ -2715,6 +3915,7 @@ static void YGNodelayoutImpl(
         heightMeasureMode,
         ownerWidth,
         ownerHeight,
+        layoutMarkerData,
         layoutContext);
     return;
   }
@@ -2822,7 +4023,11 @@ static void YGNodelayoutImpl(
 
   // STEP 3: DETERMINE FLEX BASIS FOR EACH ITEM
 
-  float totalOuterFlexBasis = YGNodeComputeFlexBasisForChildren(
+  const bool hasHomogeneousChildren =
+      YGNodeHasHomogeneousChildren(node, mainAxis, crossAxis);
+  float totalOuterFlexBasis = (hasHomogeneousChildren
+                                   ? YGNodeComputeHomogeneousFlexBasis
+                                   : YGNodeComputeFlexBasisForChildren)(
       node,
       availableInnerWidth,
       availableInnerHeight,
@@ -2856,17 +4061,40 @@ static void YGNodelayoutImpl(
 
   // Max main dimension of all the lines.
   float maxLineMainDim = 0;
+  const bool hasCollectedFlexLines = isNodeFlexWrap &&
+      !hasHomogeneousChildren && childCount >= 16 &&
+      YGNodeCollectFlexLines(
+          node,
+          mainAxis,
+          mainAxisownerSize,
+          availableInnerWidth,
+          availableInnerMainDim,
+          layoutMarkerData);
   YGCollectFlexItemsRowValues collectedFlexItemsValues;
   for (; endOfLineIndex < childCount;
        lineCount++, startOfLineIndex = endOfLineIndex) {
-    collectedFlexItemsValues = YGCalculateCollectFlexItemsRowValues(
-        node,
-        ownerDirection,
-        mainAxisownerSize,
-        availableInnerWidth,
-        availableInnerMainDim,
-        startOfLineIndex,
-        lineCount);
+    if (hasHomogeneousChildren) {
+      collectedFlexItemsValues = YGCollectHomogeneousFlexItems(
+          node,
+          mainAxis,
+          mainAxisownerSize,
+          availableInnerWidth,
+          availableInnerMainDim,
+          startOfLineIndex,
+          lineCount);
+    } else if (hasCollectedFlexLines) {
+      collectedFlexItemsValues =
+          YGCollectFlexItemsOfLine(node, startOfLineIndex, lineCount);
+    } else {
+      collectedFlexItemsValues = YGCalculateCollectFlexItemsRowValues(
+          node,
+          ownerDirection,
+          mainAxisownerSize,
+          availableInnerWidth,
+          availableInnerMainDim,
+          startOfLineIndex,
+          lineCount);
+    }
     endOfLineIndex = collectedFlexItemsValues.endOfLineIndex;
 
     // If we don't need to measure the cross axis, we can skip the entire flex
@@ -2925,7 +4153,23 @@ static void YGNodelayoutImpl(
           -collectedFlexItemsValues.sizeConsumedOnCurrentLine;
     }
 
-    if (!canSkipFlex) {
+    if (!canSkipFlex && hasHomogeneousChildren) {
+      YGResolveHomogeneousLength(
+          node,
+          collectedFlexItemsValues,
+          startOfLineIndex,
+          mainAxis,
+          crossAxis,
+          mainAxisownerSize,
+          availableInnerMainDim,
+          availableInnerCrossDim,
+          availableInnerWidth,
+          availableInnerHeight,
+          performLayout,
+          config,
+          layoutMarkerData,
+          layoutContext);
+    } else if (!canSkipFlex) {
       YGResolveFlexibleLength(
           node,
           collectedFlexItemsValues,
@@ -2955,21 +4199,35 @@ static void YGNodelayoutImpl(
     // of items that are aligned "stretch". We need to compute these stretch
     // values and set the final positions.
 
-    YGJustifyMainAxis(
-        node,
-        collectedFlexItemsValues,
-        startOfLineIndex,
-        mainAxis,
-        crossAxis,
-        measureModeMainDim,
-        measureModeCrossDim,
-        mainAxisownerSize,
-        ownerWidth,
-        availableInnerMainDim,
-        availableInnerCrossDim,
-        availableInnerWidth,
-        performLayout,
-        layoutContext);
+    if (hasHomogeneousChildren) {
+      YGJustifyHomogeneousMainAxis(
+          node,
+          collectedFlexItemsValues,
+          startOfLineIndex,
+          mainAxis,
+          crossAxis,
+          measureModeCrossDim,
+          ownerWidth,
+          availableInnerCrossDim,
+          availableInnerWidth,
+          performLayout);
+    } else {
+      YGJustifyMainAxis(
+          node,
+          collectedFlexItemsValues,
+          startOfLineIndex,
+          mainAxis,
+          crossAxis,
+          measureModeMainDim,
+          measureModeCrossDim,
+          mainAxisownerSize,
+          ownerWidth,
+          availableInnerMainDim,
+          availableInnerCrossDim,
+          availableInnerWidth,
+          performLayout,
+          layoutContext);
+    }
 
     float containerCrossAxis = availableInnerCrossDim;
     if (measureModeCrossDim == YGMeasureModeUndefined ||
@@ -3002,7 +4260,17 @@ static void YGNodelayoutImpl(
 
     // STEP 7: CROSS-AXIS ALIGNMENT
     // We can skip child alignment if we're just measuring the container.
-    if (performLayout) {
+    if (performLayout && hasHomogeneousChildren) {
+      // Homogeneous children have a definite cross size and align to the
+      // start of the line.
+      for (uint32_t i = startOfLineIndex; i < endOfLineIndex; i++) {
+        const YGNodeRef child = node->getChild(i);
+        child->setLayoutPosition(
+            child->getLayout().position[pos[crossAxis]] + totalLineCrossDim +
+                leadingPaddingAndBorderCross,
+            pos[crossAxis]);
+      }
+    } else if (performLayout) {
       for (uint32_t i = startOfLineIndex; i < endOfLineIndex; i++) {
         const YGNodeRef child = node->getChild(i);
         if (child->getStyle().display == YGDisplayNone) {
@@ -3043,14 +4311,35 @@ static void YGNodelayoutImpl(
 
           // If the child uses align stretch, we need to lay it out one more
           // time, this time forcing the cross-axis size to be the computed
-          // cross size for the current line.
+          // cross size for the current line. A child of a single line with a
+          // definite cross size was already laid out with these constraints
+          // in STEP 5, so this hits its layout cache.
           if (alignItem == YGAlignStretch &&
               child->marginLeadingValue(crossAxis).unit != YGUnitAuto &&
               child->marginTrailingValue(crossAxis).unit != YGUnitAuto) {
             // If the child defines a definite size for its cross axis, there's
             // no need to stretch.
-            if (!YGNodeIsStyleDimDefined(
-                    child, crossAxis, availableInnerCrossDim)) {
+            if (child->getLayout().isVirtualized) {
+              if (!YGNodeIsStyleDimDefined(
+                      child, crossAxis, availableInnerCrossDim)) {
+                YGNodeSetVirtualizedSize(
+                    child,
+                    mainAxis,
+                    child->getLayout().measuredDimensions[dim[mainAxis]],
+                    crossAxis,
+                    YGNodeBoundAxis(
+                        child,
+                        crossAxis,
+                        collectedFlexItemsValues.crossDim -
+                            child->getMarginForAxis(
+                                     crossAxis, availableInnerWidth)
+                                .unwrap(),
+                        availableInnerCrossDim,
+                        availableInnerWidth),
+                    true);
+              }
+            } else if (!YGNodeIsStyleDimDefined(
+                           child, crossAxis, availableInnerCrossDim)) {
               float childMainSize =
                   child->getLayout().measuredDimensions[dim[mainAxis]];
               float childCrossSize =
@@ -3113,7 +4402,7 @@ static void YGNodelayoutImpl(
                   availableInnerWidth,
                   availableInnerHeight,
                   true,
-                  "stretch",
+                  LayoutPassReason::kStretch,
                   config,
                   layoutMarkerData,
                   layoutContext);
@@ -3155,7 +4444,7 @@ static void YGNodelayoutImpl(
 
   // STEP 8: MULTI-LINE CONTENT ALIGNMENT
   // currentLead stores the size of the cross dim
-  if (performLayout && (isNodeFlexWrap || YGIsBaselineLayout(node))) {
+  if (performLayout && (isNodeFlexWrap || node->isBaselineLayout())) {
     float crossDimLead = 0;
     float currentLead = leadingPaddingAndBorderCross;
     if (!YGFloatIsUndefined(availableInnerCrossDim)) {
@@ -3321,7 +4610,7 @@ static void YGNodelayoutImpl(
                         availableInnerWidth,
                         availableInnerHeight,
                         true,
-                        "multiline-stretch",
+                        LayoutPassReason::kMultilineStretch,
                         config,
                         layoutMarkerData,
                         layoutContext);
@@ -3492,9 +4781,13 @@ static void YGNodelayoutImpl(
   }
 }
 
-uint32_t gDepth = 0;
+#ifdef YG_DISABLE_DEBUG_CHECKS
+static constexpr bool gPrintChanges = false;
+static constexpr bool gPrintSkips = false;
+#else
 bool gPrintChanges = false;
 bool gPrintSkips = false;
+#endif
 
 static const char* spacer =
     "                                                            ";
@@ -3561,26 +4854,10 @@ float YGRoundValueToPixelGrid(
     const bool forceFloor) {
   float scaledValue = value * pointScaleFactor;
   // We want to calculate `fractial` such that `floor(scaledValue) = scaledValue
-  // - fractial`.
-  float fractial = fmodf(scaledValue, 1.0f);
-  if (fractial < 0) {
-    // This branch is for handling negative numbers for `value`.
-    //
-    // Regarding `floor` and `ceil`. Note that for a number x, `floor(x) <= x <=
-    // ceil(x)` even for negative numbers. Here are a couple of examples:
-    //   - x =  2.2: floor( 2.2) =  2, ceil( 2.2) =  3
-    //   - x = -2.2: floor(-2.2) = -3, ceil(-2.2) = -2
-    //
-    // Regarding `fmodf`. For fractional negative numbers, `fmodf` returns a
-    // negative number. For example, `fmodf(-2.2) = -0.2`. However, we want
-    // `fractial` to be the number such that subtracting it from `value` will
-    // give us `floor(value)`. In the case of negative numbers, adding 1 to
-    // `fmodf(value)` gives us this. Let's continue the example from above:
-    //   - fractial = fmodf(-2.2) = -0.2
-    //   - Add 1 to the fraction: fractial2 = fractial + 1 = -0.2 + 1 = 0.8
-    //   - Finding the `floor`: -2.2 - fractial2 = -2.2 - 0.8 = -3
-    ++fractial;
-  }
+  // - fractial`. The subtraction is exact, so this is the same value as
+  // `fmodf(scaledValue, 1.0f)` (plus 1 for negative numbers), and it is
+  // undefined for undefined or infinite values too, but much cheaper.
+  const float fractial = YGFloatFraction(scaledValue);
   if (YGFloatsEqual(fractial, 0)) {
     // First we check if the value is already rounded
     scaledValue = scaledValue - fractial;
@@ -3605,6 +4882,23 @@ float YGRoundValueToPixelGrid(
       : scaledValue / pointScaleFactor;
 }
 
+// Whether two sizes round to the same size on the pixel grid, or are equal if
+// there is none. Most cache probes compare a size with itself, which needs no
+// rounding.
+static inline bool YGSizesEqualOnPixelGrid(
+    const float a,
+    const float b,
+    const float pointScaleFactor) {
+  if (a == b || (YGFloatIsUndefined(a) && YGFloatIsUndefined(b))) {
+    return true;
+  }
+  return pointScaleFactor == 0
+      ? YGFloatsEqual(a, b)
+      : YGFloatsEqual(
+            YGRoundValueToPixelGrid(a, pointScaleFactor, false, false),
+            YGRoundValueToPixelGrid(b, pointScaleFactor, false, false));
+}
+
 bool YGNodeCanUseCachedMeasurement(
     const YGMeasureMode widthMode,
     const float width,
@@ -3623,27 +4917,12 @@ bool YGNodeCanUseCachedMeasurement(
       (!YGFloatIsUndefined(lastComputedWidth) && lastComputedWidth < 0)) {
     return false;
   }
-  bool useRoundedComparison =
-      config != nullptr && config->pointScaleFactor != 0;
-  const float effectiveWidth = useRoundedComparison
-      ? YGRoundValueToPixelGrid(width, config->pointScaleFactor, false, false)
-      : width;
-  const float effectiveHeight = useRoundedComparison
-      ? YGRoundValueToPixelGrid(height, config->pointScaleFactor, false, false)
-      : height;
-  const float effectiveLastWidth = useRoundedComparison
-      ? YGRoundValueToPixelGrid(
-            lastWidth, config->pointScaleFactor, false, false)
-      : lastWidth;
-  const float effectiveLastHeight = useRoundedComparison
-      ? YGRoundValueToPixelGrid(
-            lastHeight, config->pointScaleFactor, false, false)
-      : lastHeight;
-
+  const float pointScaleFactor =
+      config != nullptr ? config->pointScaleFactor : 0.0f;
   const bool hasSameWidthSpec = lastWidthMode == widthMode &&
-      YGFloatsEqual(effectiveLastWidth, effectiveWidth);
+      YGSizesEqualOnPixelGrid(lastWidth, width, pointScaleFactor);
   const bool hasSameHeightSpec = lastHeightMode == heightMode &&
-      YGFloatsEqual(effectiveLastHeight, effectiveHeight);
+      YGSizesEqualOnPixelGrid(lastHeight, height, pointScaleFactor);
 
   const bool widthIsCompatible =
       hasSameWidthSpec ||
@@ -3677,6 +4956,126 @@ bool YGNodeCanUseCachedMeasurement(
   return widthIsCompatible && heightIsCompatible;
 }
 
+// Returns the node laid out earlier in this pass with the same structural
+// hash and constraints, if its layout is still the one it got for them.
+static YGNodeRef YGFindMemoizedLayout(
+    const LayoutData& layoutMarkerData,
+    const YGLayoutCache::Key& key,
+    const YGNodeRef node) {
+  if (layoutMarkerData.memo == nullptr) {
+    return nullptr;
+  }
+  const auto entry = layoutMarkerData.memo->layouts.find(key);
+  if (entry == layoutMarkerData.memo->layouts.end() || entry->second == node) {
+    return nullptr;
+  }
+  // The source may have been laid out again since, e.g. when it was
+  // stretched; its layout cache entry tells which constraints it has now.
+  const YGLayout& layout = entry->second->getLayout();
+  const YGCachedMeasurement& cached = layout.cachedLayout;
+  const bool isCurrent =
+      canonicalFloatBits(cached.availableWidth) == key.availableWidth &&
+      canonicalFloatBits(cached.availableHeight) == key.availableHeight &&
+      static_cast<uint32_t>(cached.widthMeasureMode) == key.widthMeasureMode &&
+      static_cast<uint32_t>(cached.heightMeasureMode) ==
+          key.heightMeasureMode &&
+      static_cast<uint32_t>(layout.lastOwnerDirection) == key.ownerDirection;
+  return isCurrent ? entry->second : nullptr;
+}
+
+static const std::array<float, 2>* YGFindMemoizedMeasurement(
+    const LayoutData& layoutMarkerData,
+    const YGLayoutCache::Key& key) {
+  if (layoutMarkerData.memo == nullptr) {
+    return nullptr;
+  }
+  const auto entry = layoutMarkerData.memo->measurements.find(key);
+  return entry != layoutMarkerData.memo->measurements.end() ? &entry->second
+                                                            : nullptr;
+}
+
+static void YGMemoize(
+    LayoutData& layoutMarkerData,
+    const YGLayoutCache::Key& key,
+    const YGNodeRef node,
+    const bool performLayout) {
+  if (layoutMarkerData.memo == nullptr) {
+    layoutMarkerData.memo.reset(new LayoutMemo());
+  }
+  if (performLayout) {
+    layoutMarkerData.memo->layouts[key] = node;
+  } else {
+    layoutMarkerData.memo->measurements[key] =
+        node->getLayout().measuredDimensions;
+  }
+}
+
+// Gives node the layout that source, an identical subtree, got for the same
+// constraints. The node's own position is left to its owner, as after
+// YGNodelayoutImpl.
+static void YGCopySubtreeLayout(const YGNodeRef source, const YGNodeRef node) {
+  const YGLayout& sourceLayout = source->getLayout();
+  YGLayout& layout = node->getLayout();
+  layout.measuredDimensions[YGDimensionWidth] =
+      sourceLayout.cachedLayout.computedWidth;
+  layout.measuredDimensions[YGDimensionHeight] =
+      sourceLayout.cachedLayout.computedHeight;
+  layout.direction = sourceLayout.direction;
+  layout.hadOverflow = sourceLayout.hadOverflow;
+  layout.isVirtualized = sourceLayout.isVirtualized;
+  layout.didUseLegacyFlag = sourceLayout.didUseLegacyFlag;
+  layout.margin = sourceLayout.margin;
+  layout.border = sourceLayout.border;
+  layout.padding = sourceLayout.padding;
+
+  // Descendants take the whole layout, caches included: they are identical
+  // and were laid out in this pass.
+  std::vector<std::pair<YGNodeRef, YGNodeRef>> stack;
+  for (size_t i = 0; i < node->getChildren().size(); i++) {
+    stack.emplace_back(source->getChildren()[i], node->getChildren()[i]);
+  }
+  while (!stack.empty()) {
+    const YGNodeRef from = stack.back().first;
+    const YGNodeRef to = stack.back().second;
+    stack.pop_back();
+
+    const std::array<float, 4> reportedFrame = to->getLayout().reportedFrame;
+    to->setLayout(from->getLayout());
+    to->getLayout().reportedFrame = reportedFrame;
+    to->setLineIndex(from->getLineIndex());
+    to->setLayoutZeroed(from->isLayoutZeroed());
+    to->setHasNewLayout(true);
+    to->setDirty(false);
+
+    for (size_t i = 0; i < to->getChildren().size(); i++) {
+      stack.emplace_back(from->getChildren()[i], to->getChildren()[i]);
+    }
+  }
+}
+
+// Returns false if the subtree cannot be cached.
+static bool YGLayoutCacheKeyForNode(
+    const YGNodeRef node,
+    const float availableWidth,
+    const float availableHeight,
+    const YGDirection ownerDirection,
+    const YGMeasureMode widthMeasureMode,
+    const YGMeasureMode heightMeasureMode,
+    const float ownerWidth,
+    const float ownerHeight,
+    YGLayoutCache::Key& key) {
+  key.hash = node->getStructuralHash();
+  key.availableWidth = canonicalFloatBits(availableWidth);
+  key.availableHeight = canonicalFloatBits(availableHeight);
+  key.ownerWidth = canonicalFloatBits(ownerWidth);
+  key.ownerHeight = canonicalFloatBits(ownerHeight);
+  key.widthMeasureMode = widthMeasureMode;
+  key.heightMeasureMode = heightMeasureMode;
+  key.ownerDirection = ownerDirection;
+  key.nodeCount = node->getSubtreeSize();
+  return node->isStructuralHashComplete();
+}
+
 //
 // This is a wrapper around the YGNodelayoutImpl function. It determines whether
 // the layout request is redundant and can be skipped.
@@ -3685,7 +5084,7 @@ bool YGNodeCanUseCachedMeasurement(
 //  Input parameters are the same as YGNodelayoutImpl (see above)
 //  Return parameter is true if layout was performed, false if skipped
 //
-bool YGLayoutNodeInternal(
+static bool YGLayoutNodeInternal(
     const YGNodeRef node,
     const float availableWidth,
     const float availableHeight,
@@ -3695,16 +5094,17 @@ bool YGLayoutNodeInternal(
     const float ownerWidth,
     const float ownerHeight,
     const bool performLayout,
-    const char* reason,
+    const LayoutPassReason reason,
     const YGConfigRef config,
-    YGMarkerLayoutData& layoutMarkerData,
+    LayoutData& layoutMarkerData,
     void* const layoutContext) {
   YGLayout* layout = &node->getLayout();
 
-  gDepth++;
+  layoutMarkerData.depth++;
 
   const bool needToVisitNode =
-      (node->isDirty() && layout->generationCount != gCurrentGenerationCount) ||
+      (node->isDirty() &&
+       layout->generationCount != layoutMarkerData.generationCount) ||
       layout->lastOwnerDirection != ownerDirection;
 
   if (needToVisitNode) {
@@ -3806,8 +5206,8 @@ bool YGLayoutNodeInternal(
           YGLogLevelVerbose,
           nullptr,
           "%s%d.{[skipped] ",
-          YGSpacer(gDepth),
-          gDepth);
+          YGSpacer(layoutMarkerData.depth),
+          layoutMarkerData.depth);
       node->print(layoutContext);
       Log::log(
           node,
@@ -3820,7 +5220,7 @@ bool YGLayoutNodeInternal(
           availableHeight,
           cachedResults->computedWidth,
           cachedResults->computedHeight,
-          reason);
+          LayoutPassReasonToString(reason));
     }
   } else {
     if (gPrintChanges) {
@@ -3829,8 +5229,8 @@ bool YGLayoutNodeInternal(
           YGLogLevelVerbose,
           nullptr,
           "%s%d.{%s",
-          YGSpacer(gDepth),
-          gDepth,
+          YGSpacer(layoutMarkerData.depth),
+          layoutMarkerData.depth,
           needToVisitNode ? "*" : "");
       node->print(layoutContext);
       Log::log(
@@ -3842,22 +5242,76 @@ bool YGLayoutNodeInternal(
           YGMeasureModeName(heightMeasureMode, performLayout),
           availableWidth,
           availableHeight,
-          reason);
+          LayoutPassReasonToString(reason));
     }
 
-    YGNodelayoutImpl(
-        node,
-        availableWidth,
-        availableHeight,
-        ownerDirection,
-        widthMeasureMode,
-        heightMeasureMode,
-        ownerWidth,
-        ownerHeight,
-        performLayout,
-        config,
-        layoutMarkerData,
-        layoutContext);
+    // The persistent layout cache only holds the roots of passes, so that it
+    // keeps one entry per tree and constraints. Leaves without a measure
+    // function are cheaper to lay out than to memoize.
+    const bool tryLayoutCache = performLayout &&
+        layoutMarkerData.depth == 1 && config->layoutCache != nullptr;
+    const bool tryMemo = config->memoizeIdenticalSubtrees &&
+        (!node->getChildren().empty() || node->hasMeasureFunc());
+    YGLayoutCache::Key layoutKey;
+    const bool hasLayoutKey = (tryLayoutCache || tryMemo) &&
+        YGLayoutCacheKeyForNode(
+            node,
+            availableWidth,
+            availableHeight,
+            ownerDirection,
+            widthMeasureMode,
+            heightMeasureMode,
+            ownerWidth,
+            ownerHeight,
+            layoutKey);
+    const bool useMemo = hasLayoutKey && tryMemo;
+    const YGNodeRef memoizedLayout = useMemo && performLayout
+        ? YGFindMemoizedLayout(layoutMarkerData, layoutKey, node)
+        : nullptr;
+    const std::array<float, 2>* const memoizedMeasurement =
+        useMemo && !performLayout
+        ? YGFindMemoizedMeasurement(layoutMarkerData, layoutKey)
+        : nullptr;
+
+    if (memoizedLayout != nullptr) {
+      YGCopySubtreeLayout(memoizedLayout, node);
+      layoutMarkerData.cachedLayouts += 1;
+    } else if (memoizedMeasurement != nullptr) {
+      layout->measuredDimensions = *memoizedMeasurement;
+      layoutMarkerData.cachedMeasures += 1;
+    } else if (
+        hasLayoutKey && tryLayoutCache &&
+        config->layoutCache->restore(node, layoutKey)) {
+      layoutMarkerData.cachedLayouts += 1;
+    } else {
+      if (layoutMarkerData.budget != nullptr) {
+        layoutMarkerData.budget->spend();
+      }
+
+      YGNodelayoutImpl(
+          node,
+          availableWidth,
+          availableHeight,
+          ownerDirection,
+          widthMeasureMode,
+          heightMeasureMode,
+          ownerWidth,
+          ownerHeight,
+          performLayout,
+          config,
+          layoutMarkerData,
+          layoutContext);
+
+      if (layoutMarkerData.budget != nullptr) {
+        layoutMarkerData.budget->completedNodes++;
+      }
+      if (hasLayoutKey && tryLayoutCache) {
+        config->layoutCache->store(node, layoutKey);
+      }
+      if (useMemo) {
+        YGMemoize(layoutMarkerData, layoutKey, node, performLayout);
+      }
+    }
 
     if (gPrintChanges) {
       Log::log(
@@ -3865,8 +5319,8 @@ bool YGLayoutNodeInternal(
           YGLogLevelVerbose,
           nullptr,
           "%s%d.}%s",
-          YGSpacer(gDepth),
-          gDepth,
+          YGSpacer(layoutMarkerData.depth),
+          layoutMarkerData.depth,
           needToVisitNode ? "*" : "");
       node->print(layoutContext);
       Log::log(
@@ -3878,7 +5332,7 @@ bool YGLayoutNodeInternal(
           YGMeasureModeName(heightMeasureMode, performLayout),
           layout->measuredDimensions[YGDimensionWidth],
           layout->measuredDimensions[YGDimensionHeight],
-          reason);
+          LayoutPassReasonToString(reason));
     }
 
     layout->lastOwnerDirection = ownerDirection;
@@ -3893,6 +5347,9 @@ bool YGLayoutNodeInternal(
         if (gPrintChanges) {
           Log::log(node, YGLogLevelVerbose, nullptr, "Out of cache entries!\n");
         }
+        // Entries past the index are never looked up, so this drops them all.
+        layoutMarkerData.cacheEvictions +=
+            static_cast<uint32_t>(usedMeasureCacheEntries);
         layout->nextCachedMeasurementsIndex = 0;
       }
 
@@ -3928,10 +5385,20 @@ bool YGLayoutNodeInternal(
 
     node->setHasNewLayout(true);
     node->setDirty(false);
+
+    if (node->isLayoutZeroed()) {
+      // Shown again. Descendants served from their caches keep the layout
+      // they had before the node was hidden, but may have been read as zero
+      // in between.
+      node->setLayoutZeroed(false);
+      node->iterChildrenAfterCloningIfNeeded(
+          YGMarkSubtreeHasNewLayout, layoutContext);
+    }
   }
 
-  gDepth--;
-  layout->generationCount = gCurrentGenerationCount;
+  layoutMarkerData.depth--;
+  layout->generationCount = layoutMarkerData.generationCount;
+  layout->baseline = YGUndefined;
   return (needToVisitNode || cachedResults == nullptr);
 }
 
@@ -3988,12 +5455,12 @@ static void YGRoundToPixelGrid(
   // We multiply dimension by scale factor and if the result is close to the
   // whole number, we don't have any fraction To verify if the result is close
   // to whole number we want to check both floor and ceil numbers
-  const bool hasFractionalWidth =
-      !YGFloatsEqual(fmodf(nodeWidth * pointScaleFactor, 1.0), 0) &&
-      !YGFloatsEqual(fmodf(nodeWidth * pointScaleFactor, 1.0), 1.0);
-  const bool hasFractionalHeight =
-      !YGFloatsEqual(fmodf(nodeHeight * pointScaleFactor, 1.0), 0) &&
-      !YGFloatsEqual(fmodf(nodeHeight * pointScaleFactor, 1.0), 1.0);
+  const float widthFraction = YGFloatFraction(nodeWidth * pointScaleFactor);
+  const float heightFraction = YGFloatFraction(nodeHeight * pointScaleFactor);
+  const bool hasFractionalWidth = !YGFloatsEqual(widthFraction, 0) &&
+      !YGFloatsEqual(widthFraction, 1.0);
+  const bool hasFractionalHeight = !YGFloatsEqual(heightFraction, 0) &&
+      !YGFloatsEqual(heightFraction, 1.0);
 
   node->setLayoutDimension(
       YGRoundValueToPixelGrid(
@@ -4015,6 +5482,9 @@ static void YGRoundToPixelGrid(
               absoluteNodeTop, pointScaleFactor, false, textRounding),
       YGDimensionHeight);
 
+  if (node->isLayoutZeroed()) {
+    return;
+  }
   const uint32_t childCount = YGNodeGetChildCount(node);
   for (uint32_t i = 0; i < childCount; i++) {
     YGRoundToPixelGrid(
@@ -4025,18 +5495,42 @@ static void YGRoundToPixelGrid(
   }
 }
 
-void YGNodeCalculateLayoutWithContext(
+static void YGReportLayoutChanges(
+    const YGNodeRef node,
+    const YGLayoutChangedFunc layoutChanged,
+    void* layoutContext) {
+  YGLayout& layout = node->getLayout();
+  const std::array<float, 4> frame = {{layout.position[YGEdgeLeft],
+                                       layout.position[YGEdgeTop],
+                                       layout.dimensions[YGDimensionWidth],
+                                       layout.dimensions[YGDimensionHeight]}};
+  if (!YGFloatArrayEqual(frame, layout.reportedFrame)) {
+    const std::array<float, 4> oldFrame = layout.reportedFrame;
+    layout.reportedFrame = frame;
+    layoutChanged(
+        node,
+        YGFrame{oldFrame[0], oldFrame[1], oldFrame[2], oldFrame[3]},
+        YGFrame{frame[0], frame[1], frame[2], frame[3]},
+        layoutContext);
+  }
+
+  if (node->isLayoutZeroed()) {
+    return;
+  }
+  for (const YGNodeRef child : node->getChildren()) {
+    YGReportLayoutChanges(child, layoutChanged, layoutContext);
+  }
+}
+
+static void YGNodeCalculateLayoutImpl(
     const YGNodeRef node,
     const float ownerWidth,
     const float ownerHeight,
     const YGDirection ownerDirection,
+    LayoutData& layoutMarkerData,
     void* layoutContext) {
-  marker::MarkerSection<YGMarkerLayout> marker{node};
-
-  // Increment the generation count. This will force the recursive routine to
-  // visit all dirty nodes at least once. Subsequent visits will be skipped if
-  // the input parameters don't change.
-  gCurrentGenerationCount++;
+  const LayoutStatsScope statsScope(
+      node->getConfig()->stats, layoutMarkerData);
   node->resolveDimension();
   float width = YGUndefined;
   YGMeasureMode widthMeasureMode = YGMeasureModeUndefined;
@@ -4092,9 +5586,9 @@ void YGNodeCalculateLayoutWithContext(
           ownerWidth,
           ownerHeight,
           true,
-          "initial",
+          LayoutPassReason::kInitial,
           node->getConfig(),
-          marker.data,
+          layoutMarkerData,
           layoutContext)) {
     node->setPosition(
         node->getLayout().direction, ownerWidth, ownerHeight, ownerWidth);
@@ -4117,17 +5611,18 @@ void YGNodeCalculateLayoutWithContext(
   // on this flag. This check would be removed once we are sure no one is
   // dependent on this flag anymore. The flag
   // `shouldDiffLayoutWithoutLegacyStretchBehaviour` in YGConfig will help to
-  // run experiments.
+  // run experiments. Only one in every `legacyStretchDiffSamplingRate` of
+  // these layouts is diffed, and the others keep the last result.
   if (node->getConfig()->shouldDiffLayoutWithoutLegacyStretchBehaviour &&
-      node->didUseLegacyFlag()) {
-    const YGNodeRef originalNode = YGNodeDeepClone(node);
+      node->didUseLegacyFlag() &&
+      YGConfigSampleLegacyStretchDiff(node->getConfig())) {
+    YGLegacyStretchDiffTree diffTree{node};
+    const YGNodeRef originalNode = diffTree.root;
     originalNode->resolveDimension();
     // Recursively mark nodes as dirty
     originalNode->markDirtyAndPropogateDownwards();
-    gCurrentGenerationCount++;
     // Rerun the layout, and calculate the diff
-    originalNode->setAndPropogateUseLegacyFlag(false);
-    YGMarkerLayoutData layoutMarkerData;
+    LayoutData diffLayoutData(++gCurrentGenerationCount);
     if (YGLayoutNodeInternal(
             originalNode,
             width,
@@ -4138,9 +5633,9 @@ void YGNodeCalculateLayoutWithContext(
             ownerWidth,
             ownerHeight,
             true,
-            "initial",
+            LayoutPassReason::kInitial,
             originalNode->getConfig(),
-            layoutMarkerData,
+            diffLayoutData,
             layoutContext)) {
       originalNode->setPosition(
           originalNode->getLayout().direction,
@@ -4168,8 +5663,27 @@ void YGNodeCalculateLayoutWithContext(
       }
 #endif
     }
-    YGConfigFreeRecursive(originalNode);
-    YGNodeFreeRecursive(originalNode);
+  }
+}
+
+void YGNodeCalculateLayoutWithContext(
+    const YGNodeRef node,
+    const float ownerWidth,
+    const float ownerHeight,
+    const YGDirection ownerDirection,
+    void* layoutContext) {
+  marker::MarkerSection<YGMarkerLayout> marker{node};
+
+  // Increment the generation count. This will force the recursive routine to
+  // visit all dirty nodes at least once. Subsequent visits will be skipped if
+  // the input parameters don't change.
+  LayoutData layoutData(++gCurrentGenerationCount);
+  YGNodeCalculateLayoutImpl(
+      node, ownerWidth, ownerHeight, ownerDirection, layoutData, layoutContext);
+  marker.data = layoutData;
+
+  if (node->getConfig()->layoutChanged != nullptr) {
+    YGReportLayoutChanges(node, node->getConfig()->layoutChanged, layoutContext);
   }
 }
 
@@ -4182,6 +5696,197 @@ void YGNodeCalculateLayout(
       node, ownerWidth, ownerHeight, ownerDirection, nullptr);
 }
 
+namespace {
+
+struct LayoutBatch {
+  const YGNodeRef* roots;
+  const YGLayoutConstraints* constraints;
+  std::vector<YGMarkerLayoutData> stats;
+};
+
+void YGLayoutBatchTask(void* taskContext, uint32_t index) {
+  LayoutBatch& batch = *static_cast<LayoutBatch*>(taskContext);
+  const YGLayoutConstraints& constraints = batch.constraints[index];
+
+  LayoutData layoutData(++gCurrentGenerationCount);
+  YGNodeCalculateLayoutImpl(
+      batch.roots[index],
+      constraints.availableWidth,
+      constraints.availableHeight,
+      constraints.ownerDirection,
+      layoutData,
+      nullptr);
+  batch.stats[index] = layoutData;
+
+  const YGNodeRef root = batch.roots[index];
+  if (root->getConfig()->layoutChanged != nullptr) {
+    YGReportLayoutChanges(root, root->getConfig()->layoutChanged, nullptr);
+  }
+}
+
+} // namespace
+
+void YGNodeCalculateLayoutBatch(
+    const YGNodeRef roots[],
+    const YGLayoutConstraints constraints[],
+    const uint32_t count,
+    const YGExecutor* executor) {
+  if (count == 0) {
+    return;
+  }
+  marker::MarkerSection<YGMarkerLayout> marker{roots[0]};
+
+  LayoutBatch batch = {
+      roots, constraints, std::vector<YGMarkerLayoutData>(count)};
+
+  if (executor != nullptr && executor->parallelFor != nullptr && count > 1) {
+    executor->parallelFor(count, YGLayoutBatchTask, &batch, executor->context);
+  } else {
+    for (uint32_t i = 0; i < count; i++) {
+      YGLayoutBatchTask(&batch, i);
+    }
+  }
+
+  for (const YGMarkerLayoutData& data : batch.stats) {
+    marker.data.layouts += data.layouts;
+    marker.data.measures += data.measures;
+    marker.data.maxMeasureCache =
+        std::max(marker.data.maxMeasureCache, data.maxMeasureCache);
+    marker.data.cachedLayouts += data.cachedLayouts;
+    marker.data.cachedMeasures += data.cachedMeasures;
+    marker.data.skippedAbsoluteLayouts += data.skippedAbsoluteLayouts;
+    marker.data.reusedFlexLines += data.reusedFlexLines;
+  }
+}
+
+struct YGLayoutTask {
+  const float ownerWidth;
+  const float ownerHeight;
+  const YGDirection ownerDirection;
+  // All slices of a task share one generation, so subtrees finished by an
+  // earlier slice are served from the layout cache by the next one.
+  const uint32_t generationCount;
+  // Pairs of (original, working copy) in pre-order. The pass runs on the
+  // copies, and results are copied back only once it completes.
+  std::vector<std::pair<YGNodeRef, YGNodeRef>> nodes;
+  bool isComplete = false;
+
+  YGLayoutTask(
+      float ownerWidth,
+      float ownerHeight,
+      YGDirection ownerDirection,
+      uint32_t generationCount)
+      : ownerWidth(ownerWidth),
+        ownerHeight(ownerHeight),
+        ownerDirection(ownerDirection),
+        generationCount(generationCount) {}
+
+  void freeCopies() {
+    for (const auto& pair : nodes) {
+      delete pair.second;
+    }
+    nodes.clear();
+  }
+
+  void commit() {
+    for (const auto& pair : nodes) {
+      const YGNodeRef node = pair.first;
+      const YGNodeRef copy = pair.second;
+      YGLayout layout = copy->getLayout();
+      layout.reportedFrame = node->getLayout().reportedFrame;
+      node->setLayout(layout);
+      node->setLineIndex(copy->getLineIndex());
+      node->setHasNewLayout(copy->getHasNewLayout());
+      node->setLayoutZeroed(copy->isLayoutZeroed());
+      node->setDirty(copy->isDirty());
+      node->resolveDimension();
+    }
+  }
+};
+
+YGLayoutTaskRef YGLayoutTaskNew(
+    const YGNodeRef root,
+    const float ownerWidth,
+    const float ownerHeight,
+    const YGDirection ownerDirection) {
+  const YGLayoutTaskRef task = new YGLayoutTask(
+      ownerWidth, ownerHeight, ownerDirection, ++gCurrentGenerationCount);
+
+  // The root copy keeps the original owner; every other copy is owned by the
+  // copy of its owner, so the pass never clones or touches the original tree.
+  task->nodes.emplace_back(root, new YGNode(*root));
+  for (size_t i = 0; i < task->nodes.size(); i++) {
+    const YGNodeRef node = task->nodes[i].first;
+    const YGNodeRef copy = task->nodes[i].second;
+    YGVector children = node->getChildren();
+    for (YGNodeRef& child : children) {
+      YGAssertWithNode(
+          child,
+          child->getOwner() == node,
+          "Cannot run a layout task on a tree with shared children");
+      const YGNodeRef childCopy = new YGNode(*child);
+      childCopy->setOwner(copy);
+      task->nodes.emplace_back(child, childCopy);
+      child = childCopy;
+    }
+    copy->setChildren(std::move(children));
+  }
+  return task;
+}
+
+bool YGLayoutTaskRun(
+    const YGLayoutTaskRef task,
+    const uint32_t nodeBudget,
+    const float timeBudgetMs) {
+  if (task->isComplete) {
+    return true;
+  }
+
+  const YGNodeRef root = task->nodes[0].first;
+  const YGNodeRef rootCopy = task->nodes[0].second;
+  marker::MarkerSection<YGMarkerLayout> marker{root};
+
+  LayoutBudget budget;
+  budget.remainingNodes =
+      nodeBudget > 0 ? nodeBudget : std::numeric_limits<uint32_t>::max();
+  budget.hasDeadline = timeBudgetMs > 0;
+  if (budget.hasDeadline) {
+    budget.deadline = LayoutBudget::Clock::now() +
+        std::chrono::duration_cast<LayoutBudget::Clock::duration>(
+            std::chrono::duration<float, std::milli>(timeBudgetMs));
+  }
+
+  LayoutData layoutData(task->generationCount);
+  layoutData.budget = &budget;
+  try {
+    YGNodeCalculateLayoutImpl(
+        rootCopy,
+        task->ownerWidth,
+        task->ownerHeight,
+        task->ownerDirection,
+        layoutData,
+        nullptr);
+  } catch (const LayoutInterrupted&) {
+    marker.data = layoutData;
+    return false;
+  }
+  marker.data = layoutData;
+
+  task->commit();
+  task->freeCopies();
+  task->isComplete = true;
+
+  if (root->getConfig()->layoutChanged != nullptr) {
+    YGReportLayoutChanges(root, root->getConfig()->layoutChanged, nullptr);
+  }
+  return true;
+}
+
+void YGLayoutTaskFree(const YGLayoutTaskRef task) {
+  task->freeCopies();
+  delete task;
+}
+
 void YGConfigSetLogger(const YGConfigRef config, YGLogger logger) {
   if (logger != nullptr) {
     config->setLogger(logger);
@@ -4200,6 +5905,15 @@ void YGConfigSetShouldDiffLayoutWithoutLegacyStretchBehaviour(
   config->shouldDiffLayoutWithoutLegacyStretchBehaviour = shouldDiffLayout;
 }
 
+void YGConfigSetLegacyStretchDiffSamplingRate(
+    const YGConfigRef config,
+    const uint32_t samplingRate) {
+  YGAssertWithConfig(
+      config, samplingRate > 0, "The sampling rate must be at least 1");
+  config->legacyStretchDiffSamplingRate = samplingRate;
+  config->legacyStretchDiffCountdown = 0;
+}
+
 void YGAssert(const bool condition, const char* message) {
   if (!condition) {
     Log::log(YGNodeRef{nullptr}, YGLogLevelFatal, nullptr, "%s\n", message);
@@ -4265,21 +5979,191 @@ void YGConfigSetCloneNodeFunc(
   config->setCloneNodeCallback(callback);
 }
 
-static void YGTraverseChildrenPreOrder(
-    const YGVector& children,
-    const std::function<void(YGNodeRef node)>& f) {
-  for (YGNodeRef node : children) {
-    f(node);
-    YGTraverseChildrenPreOrder(node->getChildren(), f);
+void YGConfigSetLayoutChangedFunc(
+    const YGConfigRef config,
+    const YGLayoutChangedFunc callback) {
+  config->layoutChanged = callback;
+}
+
+YGConfigStats YGConfigGetStats(const YGConfigRef config) {
+  const YGConfig::Stats& stats = config->stats;
+  const auto load = [](const std::atomic<uint64_t>& counter) {
+    return counter.load(std::memory_order_relaxed);
+  };
+  return YGConfigStats{load(stats.layoutPasses),
+                       load(stats.nodesVisited),
+                       load(stats.measureCalls),
+                       load(stats.cacheHits),
+                       load(stats.cacheMisses),
+                       load(stats.cacheEvictions),
+                       load(stats.clones),
+                       load(stats.bytesAllocated),
+                       load(stats.layoutTimeNs)};
+}
+
+void YGConfigResetStats(const YGConfigRef config) {
+  YGConfig::Stats& stats = config->stats;
+  for (std::atomic<uint64_t>* counter : {&stats.layoutPasses,
+                                         &stats.nodesVisited,
+                                         &stats.measureCalls,
+                                         &stats.cacheHits,
+                                         &stats.cacheMisses,
+                                         &stats.cacheEvictions,
+                                         &stats.clones,
+                                         &stats.bytesAllocated,
+                                         &stats.layoutTimeNs}) {
+    counter->store(0, std::memory_order_relaxed);
   }
 }
 
-void YGTraversePreOrder(
+YGLayoutCacheRef YGLayoutCacheNew(const char* path) {
+  return new YGLayoutCache(path);
+}
+
+void YGLayoutCacheFree(const YGLayoutCacheRef cache) {
+  delete cache;
+}
+
+bool YGLayoutCacheSave(const YGLayoutCacheRef cache) {
+  return cache->save();
+}
+
+uint32_t YGLayoutCacheGetEntryCount(const YGLayoutCacheRef cache) {
+  return static_cast<uint32_t>(cache->size());
+}
+
+void YGConfigSetMemoizeIdenticalSubtrees(
+    const YGConfigRef config,
+    const bool enabled) {
+  config->memoizeIdenticalSubtrees = enabled;
+}
+
+bool YGConfigGetMemoizeIdenticalSubtrees(const YGConfigRef config) {
+  return config->memoizeIdenticalSubtrees;
+}
+
+void YGNodeSetContentKey(const YGNodeRef node, const uint64_t contentKey) {
+  node->setContentKey(contentKey);
+}
+
+uint64_t YGNodeGetContentKey(const YGNodeRef node) {
+  return node->getContentKey();
+}
+
+void YGConfigSetLayoutCache(
+    const YGConfigRef config,
+    const YGLayoutCacheRef cache) {
+  config->layoutCache = cache;
+}
+
+uint64_t YGNodeGetStructuralHash(const YGNodeRef node) {
+  return node->getStructuralHash();
+}
+
+// Visits the subtree iteratively. A traversal stopped elsewhere, as signalled
+// by `stopped`, ends this one too.
+static bool YGVisitSubtree(
+    const YGNodeRef root,
+    const YGVisitor& visitor,
+    std::atomic<bool>& stopped) {
+  std::vector<YGNodeRef> stack = {root};
+  while (!stack.empty()) {
+    if (stopped.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    const YGNodeRef node = stack.back();
+    stack.pop_back();
+    switch (visitor(node)) {
+      case YGVisitResult::Continue: {
+        const YGVector& children = node->getChildren();
+        // Push in reverse so the first child is visited next.
+        for (size_t i = children.size(); i > 0; i--) {
+          stack.push_back(children[i - 1]);
+        }
+        break;
+      }
+      case YGVisitResult::SkipChildren:
+        break;
+      case YGVisitResult::Stop:
+        stopped = true;
+        return false;
+    }
+  }
+  return true;
+}
+
+bool YGVisitPreOrder(YGNodeRef const node, const YGVisitor& visitor) {
+  if (!node) {
+    return true;
+  }
+  std::atomic<bool> stopped(false);
+  return YGVisitSubtree(node, visitor, stopped);
+}
+
+namespace {
+struct ParallelVisit {
+  const std::vector<YGNodeRef>& subtrees;
+  const YGVisitor& visitor;
+  std::atomic<bool> stopped;
+};
+
+void YGParallelVisitTask(void* taskContext, uint32_t index) {
+  ParallelVisit& visit = *static_cast<ParallelVisit*>(taskContext);
+  YGVisitSubtree(visit.subtrees[index], visit.visitor, visit.stopped);
+}
+} // namespace
+
+bool YGVisitPreOrderParallel(
     YGNodeRef const node,
-    std::function<void(YGNodeRef node)>&& f) {
+    const YGVisitor& visitor,
+    const YGExecutor* executor) {
+  if (executor == nullptr || executor->parallelFor == nullptr) {
+    return YGVisitPreOrder(node, visitor);
+  }
   if (!node) {
-    return;
+    return true;
+  }
+
+  // Visit the top of the tree level by level until there are enough subtrees
+  // to keep the executor's threads busy, then hand one subtree to each task.
+  constexpr size_t kMinSubtrees = 64;
+  std::vector<YGNodeRef> subtrees = {node};
+  while (!subtrees.empty() && subtrees.size() < kMinSubtrees) {
+    std::vector<YGNodeRef> next;
+    for (const YGNodeRef subtree : subtrees) {
+      switch (visitor(subtree)) {
+        case YGVisitResult::Continue:
+          next.insert(
+              next.end(),
+              subtree->getChildren().begin(),
+              subtree->getChildren().end());
+          break;
+        case YGVisitResult::SkipChildren:
+          break;
+        case YGVisitResult::Stop:
+          return false;
+      }
+    }
+    subtrees.swap(next);
   }
-  f(node);
-  YGTraverseChildrenPreOrder(node->getChildren(), f);
+  if (subtrees.empty()) {
+    return true;
+  }
+
+  ParallelVisit visit{subtrees, visitor, {false}};
+  executor->parallelFor(
+      static_cast<uint32_t>(subtrees.size()),
+      YGParallelVisitTask,
+      &visit,
+      executor->context);
+  return !visit.stopped;
+}
+
+void YGTraversePreOrder(
+    YGNodeRef const node,
+    std::function<void(YGNodeRef node)>&& f) {
+  YGVisitPreOrder(node, [&f](YGNodeRef visited) {
+    f(visited);
+    return YGVisitResult::Continue;
+  });
 }
@@ -28,6 +28,25 @@ typedef struct YGSize {
   float height;
 } YGSize;
 
+typedef struct YGFrame {
+  float left;
+  float top;
+  float width;
+  float height;
+} YGFrame;
+
+// Visible window of an overflow-scroll container, along its main axis and in
+// the container's coordinates (0 is its leading border edge).
+typedef struct YGViewport {
+  float offset;
+  float length;
+  // Extra distance on both sides of the window in which children are still
+  // laid out, so that small scrolls don't expose estimated children.
+  float overscan;
+  // Main-axis size assumed for children that have never been measured.
+  float estimatedChildSize;
+} YGViewport;
+
 typedef struct YGConfig* YGConfigRef;
 
 typedef struct YGNode* YGNodeRef;
@@ -51,6 +70,21 @@ typedef int (*YGLogger)(
     va_list args);
 typedef YGNodeRef (
     *YGCloneNodeFunc)(YGNodeRef oldNode, YGNodeRef owner, int childIndex);
+typedef void (*YGTaskFunc)(void* taskContext, uint32_t index);
+typedef void (*YGDispatchFunc)(
+    YGTaskFunc task,
+    void* taskContext,
+    void* dispatcherContext);
+typedef void (*YGParallelForFunc)(
+    uint32_t count,
+    YGTaskFunc task,
+    void* taskContext,
+    void* executorContext);
+typedef void (*YGLayoutChangedFunc)(
+    YGNodeRef node,
+    YGFrame oldFrame,
+    YGFrame newFrame,
+    void* layoutContext);
 
 // YGNode
 WIN_EXPORT YGNodeRef YGNodeNew(void);
@@ -61,6 +95,24 @@ WIN_EXPORT void YGNodeFreeRecursiveWithCleanupFunc(
     const YGNodeRef node,
     YGNodeCleanupFunc cleanup);
 WIN_EXPORT void YGNodeFreeRecursive(const YGNodeRef node);
+
+// Runs work later, off the calling thread. dispatch must call
+// task(taskContext, 0) exactly once, on any thread; it may return before the
+// task has run.
+typedef struct YGDispatcher {
+  YGDispatchFunc dispatch;
+  void* context;
+} YGDispatcher;
+
+// Detaches the node from its owner and returns; the tree is then freed by the
+// dispatcher, or on a new thread when it is null. The cleanup function runs
+// there too. The tree must not be used after this call, and its nodes must not
+// be shared with other trees (shared children owned elsewhere are fine).
+WIN_EXPORT void YGNodeFreeRecursiveAsync(
+    const YGNodeRef node,
+    YGNodeCleanupFunc cleanup,
+    const YGDispatcher* dispatcher);
+
 WIN_EXPORT void YGNodeReset(const YGNodeRef node);
 WIN_EXPORT int32_t YGNodeGetInstanceCount(void);
 
@@ -80,6 +132,48 @@ WIN_EXPORT void YGNodeSetChildren(
     const YGNodeRef children[],
     const uint32_t count);
 
+// Creates a whole tree in one call. Nodes are described in pre-order:
+// parentIndex[0] must be negative (the root) and every other node's parent
+// must appear before it; children keep their index order. styleTemplates and
+// measureFuncs are optional (as are their entries); a template node's style is
+// copied onto the new node. If nodesOut is non-null it receives the created
+// nodes. Returns the root, which is the only node marked dirty.
+WIN_EXPORT YGNodeRef YGTreeBuild(
+    const YGConfigRef config,
+    const uint32_t count,
+    const int32_t parentIndex[],
+    const YGNodeRef styleTemplates[],
+    const YGMeasureFunc measureFuncs[],
+    YGNodeRef nodesOut[]);
+
+// A pool allocates nodes in large chunks and numbers them with 32-bit handles,
+// for documents with millions of nodes. Pooled nodes are ordinary nodes for
+// the rest of the API; they are freed all at once by YGNodePoolFree, never
+// individually. Clones of pooled nodes are allocated on the heap as usual.
+typedef struct YGNodePool* YGNodePoolRef;
+typedef uint32_t YGNodeHandle;
+#define YGNodeHandleUndefined ((YGNodeHandle) 0xFFFFFFFF)
+
+WIN_EXPORT YGNodePoolRef YGNodePoolNew(const YGConfigRef config);
+// Frees the pool and every node allocated from it. Pooled nodes must not
+// remain attached to nodes outside the pool.
+WIN_EXPORT void YGNodePoolFree(const YGNodePoolRef pool);
+WIN_EXPORT YGNodeRef YGNodePoolNewNode(const YGNodePoolRef pool);
+WIN_EXPORT uint32_t YGNodePoolGetNodeCount(const YGNodePoolRef pool);
+// Handles are dense: the n-th node allocated from a pool has handle n.
+// Returns nullptr, respectively YGNodeHandleUndefined, for a handle or node
+// that doesn't belong to the pool.
+WIN_EXPORT YGNodeRef
+YGNodePoolGetNode(const YGNodePoolRef pool, const YGNodeHandle handle);
+WIN_EXPORT YGNodeHandle
+YGNodePoolGetHandle(const YGNodePoolRef pool, const YGNodeRef node);
+// Writes the handles of the node's children to `handles`, which must have room
+// for YGNodeGetChildCount(node) entries, and returns the count.
+WIN_EXPORT uint32_t YGNodePoolGetChildHandles(
+    const YGNodePoolRef pool,
+    const YGNodeRef node,
+    YGNodeHandle handles[]);
+
 WIN_EXPORT void YGNodeSetIsReferenceBaseline(
     YGNodeRef node,
     bool isReferenceBaseline);
@@ -92,6 +186,57 @@ WIN_EXPORT void YGNodeCalculateLayout(
     const float availableHeight,
     const YGDirection ownerDirection);
 
+typedef struct YGLayoutConstraints {
+  float availableWidth;
+  float availableHeight;
+  YGDirection ownerDirection;
+} YGLayoutConstraints;
+
+// Hands work to a host thread pool. parallelFor must call task(taskContext, i)
+// exactly once for every i in [0, count), in any order and on any threads, and
+// return only once all calls have finished.
+typedef struct YGExecutor {
+  YGParallelForFunc parallelFor;
+  void* context;
+} YGExecutor;
+
+// Lays out `count` independent trees, as YGNodeCalculateLayout would for each
+// root with its constraints. With a non-null executor the trees are laid out
+// concurrently, so the trees must not share nodes, and measure and baseline
+// functions must be safe to call from the executor's threads. A single layout
+// marker, reported against roots[0], carries counters summed over all trees.
+WIN_EXPORT void YGNodeCalculateLayoutBatch(
+    const YGNodeRef roots[],
+    const YGLayoutConstraints constraints[],
+    const uint32_t count,
+    const YGExecutor* executor);
+
+// A layout pass that can be split into slices and spread across frames. The
+// task works on a private copy of the tree taken by YGLayoutTaskNew, so the
+// tree must not be mutated or freed until the task completes or is freed.
+// Measure and baseline functions are called with the copies, which carry the
+// original nodes' contexts. Results are written back to the tree all at once,
+// by the slice that completes the pass.
+typedef struct YGLayoutTask* YGLayoutTaskRef;
+
+WIN_EXPORT YGLayoutTaskRef YGLayoutTaskNew(
+    const YGNodeRef root,
+    const float availableWidth,
+    const float availableHeight,
+    const YGDirection ownerDirection);
+
+// Runs the pass until it completes, `nodeBudget` nodes have been laid out or
+// measured, or `timeBudgetMs` have passed, and returns whether it completed.
+// A budget of 0 means no limit. Every slice makes progress, even when the
+// budget is smaller than the work a single node needs.
+WIN_EXPORT bool YGLayoutTaskRun(
+    const YGLayoutTaskRef task,
+    const uint32_t nodeBudget,
+    const float timeBudgetMs);
+
+// Frees the task. Freeing an incomplete task discards its results.
+WIN_EXPORT void YGLayoutTaskFree(const YGLayoutTaskRef task);
+
 // Mark a node as dirty. Only valid for nodes with a custom measure function
 // set.
 //
@@ -129,6 +274,13 @@ WIN_EXPORT void YGNodeCopyStyle(
     const YGNodeRef dstNode,
     const YGNodeRef srcNode);
 
+// Groups several style setters on one node. Setters called between
+// YGNodeStyleBeginBatch and YGNodeStyleCommit only record that the style
+// changed; the node is marked dirty (and the dirtied callback invoked) once, on
+// commit. Returns whether any setter in the batch changed the style.
+WIN_EXPORT void YGNodeStyleBeginBatch(const YGNodeRef node);
+WIN_EXPORT bool YGNodeStyleCommit(const YGNodeRef node);
+
 WIN_EXPORT void* YGNodeGetContext(YGNodeRef node);
 WIN_EXPORT void YGNodeSetContext(YGNodeRef node, void* context);
 void YGConfigSetPrintTreeFlag(YGConfigRef config, bool enabled);
@@ -144,6 +296,20 @@ WIN_EXPORT void YGNodeSetHasNewLayout(YGNodeRef node, bool hasNewLayout);
 YGNodeType YGNodeGetNodeType(YGNodeRef node);
 void YGNodeSetNodeType(YGNodeRef node, YGNodeType nodeType);
 WIN_EXPORT bool YGNodeIsDirty(YGNodeRef node);
+
+// Virtualizes the children of an overflow-scroll container. Children outside
+// the viewport (plus overscan) are not laid out: they keep the size of their
+// last layout, or get estimatedChildSize if they have none, and are only
+// positioned. Moving the viewport dirties the container, so the next layout
+// lays out just the children that scrolled into view; the others are served
+// from the layout cache.
+//
+// Only applies to non-wrapping containers with justifyContent flex-start, a
+// non-reversed main axis and no baseline alignment, and only to children that
+// don't grow or shrink. A viewport with an undefined length turns
+// virtualization off, which is the default.
+WIN_EXPORT void YGNodeSetViewport(YGNodeRef node, YGViewport viewport);
+WIN_EXPORT YGViewport YGNodeGetViewport(YGNodeRef node);
 bool YGNodeLayoutGetDidUseLegacyFlag(const YGNodeRef node);
 
 WIN_EXPORT void YGNodeStyleSetDirection(
@@ -326,6 +492,8 @@ WIN_EXPORT void YGNodeStyleSetAspectRatio(
     const float aspectRatio);
 WIN_EXPORT float YGNodeStyleGetAspectRatio(const YGNodeRef node);
 
+// Nodes inside a display: none subtree read as zero, but only the display:
+// none node itself has its layout reset and is flagged with a new layout.
 WIN_EXPORT float YGNodeLayoutGetLeft(const YGNodeRef node);
 WIN_EXPORT float YGNodeLayoutGetTop(const YGNodeRef node);
 WIN_EXPORT float YGNodeLayoutGetRight(const YGNodeRef node);
@@ -334,6 +502,9 @@ WIN_EXPORT float YGNodeLayoutGetWidth(const YGNodeRef node);
 WIN_EXPORT float YGNodeLayoutGetHeight(const YGNodeRef node);
 WIN_EXPORT YGDirection YGNodeLayoutGetDirection(const YGNodeRef node);
 WIN_EXPORT bool YGNodeLayoutGetHadOverflow(const YGNodeRef node);
+// Whether the node was left out of the last layout of its virtualized owner,
+// in which case its size is an estimate. See YGNodeSetViewport.
+WIN_EXPORT bool YGNodeLayoutGetIsVirtualized(const YGNodeRef node);
 bool YGNodeLayoutGetDidLegacyStretchFlagAffectLayout(const YGNodeRef node);
 
 // Get the computed values for these nodes after performing layout. If they were
@@ -364,6 +535,12 @@ WIN_EXPORT void YGConfigSetPointScaleFactor(
 void YGConfigSetShouldDiffLayoutWithoutLegacyStretchBehaviour(
     const YGConfigRef config,
     const bool shouldDiffLayout);
+// Only diff one in every `samplingRate` layouts that used the legacy stretch
+// behaviour; the others keep the result of the last diff. Defaults to 1, which
+// diffs every layout.
+WIN_EXPORT void YGConfigSetLegacyStretchDiffSamplingRate(
+    const YGConfigRef config,
+    const uint32_t samplingRate);
 
 // Yoga previously had an error where containers would take the maximum space
 // possible instead of the minimum like they are supposed to. In practice this
@@ -399,6 +576,86 @@ WIN_EXPORT void YGConfigSetCloneNodeFunc(
     const YGConfigRef config,
     const YGCloneNodeFunc callback);
 
+// When set on the config of a layout root, the callback is invoked at the end
+// of every YGNodeCalculateLayout for each node whose final (rounded) frame
+// differs from the frame reported for it by the previous pass. Nodes that have
+// never been reported before use an undefined old frame. The frame is relative
+// to the node's parent, like YGNodeLayoutGetLeft/Top/Width/Height. Nodes
+// inside a display: none subtree are not reported.
+WIN_EXPORT void YGConfigSetLayoutChangedFunc(
+    const YGConfigRef config,
+    const YGLayoutChangedFunc callback);
+
+// Cumulative counters, kept per config since it was created or last reset.
+// Layout passes are counted on the config of their root; clones and
+// allocations on the config of the node.
+typedef struct YGConfigStats {
+  uint64_t layoutPasses;
+  // Every node a pass visited, whether it was laid out, measured or served
+  // from the cache: nodesVisited == cacheHits + cacheMisses.
+  uint64_t nodesVisited;
+  uint64_t measureCalls;
+  uint64_t cacheHits;
+  uint64_t cacheMisses;
+  // Measurement cache entries dropped because a node ran out of entries.
+  uint64_t cacheEvictions;
+  uint64_t clones;
+  uint64_t bytesAllocated;
+  uint64_t layoutTimeNs;
+} YGConfigStats;
+
+// Reading the stats is cheap and safe while other threads lay out.
+WIN_EXPORT YGConfigStats YGConfigGetStats(const YGConfigRef config);
+WIN_EXPORT void YGConfigResetStats(const YGConfigRef config);
+
+// A layout cache remembers the layout of whole trees by a hash of their
+// structure and the constraints they were laid out with, and can be saved to
+// a file so that the next process starts with it. When a config with a cache
+// lays out a dirty root whose tree has been laid out before with the same
+// constraints, the stored layout is used instead. Trees with measure or
+// baseline functions are only cached if those nodes have a content key (see
+// YGNodeSetContentKey), as their results are not otherwise part of the hash.
+//
+// The file at path, if any, is loaded when the cache is created. A file
+// written by another version of the format is ignored. A null path keeps the
+// cache in memory only.
+typedef struct YGLayoutCache* YGLayoutCacheRef;
+
+WIN_EXPORT YGLayoutCacheRef YGLayoutCacheNew(const char* path);
+WIN_EXPORT void YGLayoutCacheFree(const YGLayoutCacheRef cache);
+// Returns false if the cache has no path or could not be written.
+WIN_EXPORT bool YGLayoutCacheSave(const YGLayoutCacheRef cache);
+WIN_EXPORT uint32_t YGLayoutCacheGetEntryCount(const YGLayoutCacheRef cache);
+
+// The cache is not owned by the config and can be shared between configs.
+WIN_EXPORT void YGConfigSetLayoutCache(
+    const YGConfigRef config,
+    const YGLayoutCacheRef cache);
+
+// Hash of the styles, node types, content keys and topology of the tree under
+// node, and of the config settings that change its layout. Equal trees have
+// equal hashes in every process. The hash is kept on each node and only
+// recomputed for the nodes that changed and their ancestors.
+WIN_EXPORT uint64_t YGNodeGetStructuralHash(const YGNodeRef node);
+
+// Identifies what the node's measure and baseline functions measure, e.g. a
+// hash of its text and font. Nodes with equal keys must measure the same.
+// Subtrees whose measured nodes all have a key can be served from
+// YGLayoutCache and from subtree memoization. 0, the default, means no key.
+WIN_EXPORT void YGNodeSetContentKey(
+    const YGNodeRef node,
+    const uint64_t contentKey);
+WIN_EXPORT uint64_t YGNodeGetContentKey(const YGNodeRef node);
+
+// When enabled on the config of a layout root, a subtree that is identical to
+// one already laid out in the same pass with the same constraints, by
+// structural hash, takes a copy of that layout instead of being laid out.
+// Meant for lists of identical items. Disabled by default.
+WIN_EXPORT void YGConfigSetMemoizeIdenticalSubtrees(
+    const YGConfigRef config,
+    const bool enabled);
+WIN_EXPORT bool YGConfigGetMemoizeIdenticalSubtrees(const YGConfigRef config);
+
 // Export only for C#
 WIN_EXPORT YGConfigRef YGConfigGetDefault(void);
 
@@ -423,6 +680,31 @@ extern void YGTraversePreOrder(
     YGNodeRef const node,
     std::function<void(YGNodeRef node)>&& f);
 
+enum class YGVisitResult {
+  Continue,
+  // Don't visit the descendants of this node.
+  SkipChildren,
+  // End the traversal.
+  Stop,
+};
+
+using YGVisitor = std::function<YGVisitResult(YGNodeRef node)>;
+
+// Calls visitor on each node of the tree in pre-order, including the given
+// node. The traversal uses an explicit stack, so it works on trees of any
+// depth. Returns false if the visitor stopped it.
+extern bool YGVisitPreOrder(YGNodeRef const node, const YGVisitor& visitor);
+
+// Like YGVisitPreOrder, but spreads independent subtrees across the executor,
+// so the visitor must be safe to call concurrently and must not mutate the
+// tree. Every node is still visited before its descendants, but there is no
+// order between subtrees, and a Stop ends the traversal as soon as the
+// subtrees already running notice it. Runs sequentially without an executor.
+extern bool YGVisitPreOrderParallel(
+    YGNodeRef const node,
+    const YGVisitor& visitor,
+    const YGExecutor* executor);
+
 extern void YGNodeSetChildren(
     YGNodeRef const owner,
     const std::vector<YGNodeRef>& children);
@@ -0,0 +1,436 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <yoga/Yoga.h>
+
+#define NUM_REPETITIONS 20
+
+using Clock = std::chrono::steady_clock;
+
+#define YGBENCHMARKS(...)                  \
+  int main(int argc, char const* argv[]) { \
+    Clock::time_point __start;             \
+    double __durations[NUM_REPETITIONS];   \
+    {__VA_ARGS__};                         \
+    return 0;                              \
+  }
+
+#define YGBENCHMARK(NAME, ...)                                              \
+  for (uint32_t __i = 0; __i < NUM_REPETITIONS; __i++) {                    \
+    __start = Clock::now();                                                 \
+    {__VA_ARGS__};                                                          \
+    __durations[__i] =                                                      \
+        std::chrono::duration<double, std::milli>(Clock::now() - __start)   \
+            .count();                                                       \
+  }                                                                         \
+  __printBenchmarkResult(NAME, __durations);
+
+// Counts every heap allocation and free made through operator new and
+// delete, including the library's, so that benchmarks can report them.
+static std::atomic<uint64_t> __allocations(0);
+static std::atomic<uint64_t> __frees(0);
+
+void* operator new(size_t size) {
+  __allocations++;
+  void* p = malloc(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  if (p != nullptr) {
+    __frees++;
+  }
+  free(p);
+}
+
+#define YGALLOCBENCHMARK(NAME, ...)                                 \
+  {                                                                 \
+    const uint64_t __allocationsBefore = __allocations;             \
+    const uint64_t __freesBefore = __frees;                         \
+    {__VA_ARGS__};                                                  \
+    printf(                                                         \
+        "%s: %llu allocations, %llu frees\n",                       \
+        NAME,                                                       \
+        static_cast<unsigned long long>(                            \
+            __allocations - __allocationsBefore),                   \
+        static_cast<unsigned long long>(__frees - __freesBefore));  \
+  }
+
+// Reports the work one run of a layout did, from the stats of its config.
+#define YGSTATSBENCHMARK(NAME, CONFIG, ...)                        \
+  {                                                                \
+    YGConfigResetStats(CONFIG);                                    \
+    {__VA_ARGS__};                                                 \
+    const YGConfigStats __stats = YGConfigGetStats(CONFIG);        \
+    printf(                                                        \
+        "%s: %llu measure calls, %llu cache misses, %llu hits\n",  \
+        NAME,                                                      \
+        static_cast<unsigned long long>(__stats.measureCalls),     \
+        static_cast<unsigned long long>(__stats.cacheMisses),      \
+        static_cast<unsigned long long>(__stats.cacheHits));       \
+  }
+
+static int __compareDoubles(const void* a, const void* b) {
+  const double arg1 = *(const double*)a;
+  const double arg2 = *(const double*)b;
+  return (arg1 > arg2) - (arg1 < arg2);
+}
+
+static void __printBenchmarkResult(const char* name, double durations[]) {
+  double mean = 0;
+  for (uint32_t i = 0; i < NUM_REPETITIONS; i++) {
+    mean += durations[i];
+  }
+  mean /= NUM_REPETITIONS;
+
+  qsort(durations, NUM_REPETITIONS, sizeof(double), __compareDoubles);
+  const double median = durations[NUM_REPETITIONS / 2];
+
+  double variance = 0;
+  for (uint32_t i = 0; i < NUM_REPETITIONS; i++) {
+    variance += pow(durations[i] - mean, 2);
+  }
+  variance /= NUM_REPETITIONS;
+  const double stddev = sqrt(variance);
+
+  printf("%s: median: %lf ms, stddev: %lf ms\n", name, median, stddev);
+}
+
+static YGSize _measure(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  return YGSize{widthMode == YGMeasureModeUndefined ? 10 : width,
+                heightMode == YGMeasureModeUndefined ? 10 : height};
+}
+
+// A wide, shallow tree: every node at depth 1 and 2 has `fanout` children.
+static std::vector<int32_t> __wideTreeParents(const uint32_t fanout) {
+  std::vector<int32_t> parents = {-1};
+  for (uint32_t i = 0; i < fanout; i++) {
+    const int32_t child = static_cast<int32_t>(parents.size());
+    parents.push_back(0);
+    for (uint32_t j = 0; j < fanout; j++) {
+      parents.push_back(child);
+    }
+  }
+  return parents;
+}
+
+// Runs the tasks on one thread per hardware core, pulling indices from a
+// shared counter.
+static void __threadPoolParallelFor(
+    uint32_t count,
+    YGTaskFunc task,
+    void* taskContext,
+    void* executorContext) {
+  std::atomic<uint32_t> next(0);
+  const uint32_t workers = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::thread> threads;
+  for (uint32_t w = 0; w < workers; w++) {
+    threads.emplace_back([&]() {
+      for (uint32_t i = next++; i < count; i = next++) {
+        task(taskContext, i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+static YGNodeRef __createCellTree() {
+  const YGNodeRef root = YGNodeNew();
+  for (uint32_t i = 0; i < 100; i++) {
+    const YGNodeRef row = YGNodeNew();
+    YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+    YGNodeStyleSetPadding(row, YGEdgeAll, 4);
+    for (uint32_t j = 0; j < 3; j++) {
+      const YGNodeRef label = YGNodeNew();
+      YGNodeSetMeasureFunc(label, _measure);
+      YGNodeStyleSetFlexGrow(label, 1);
+      YGNodeInsertChild(row, label, j);
+    }
+    YGNodeInsertChild(root, row, i);
+  }
+  return root;
+}
+
+// Cards of an image and two text labels, whose measure functions share a
+// content key.
+static YGNodeRef __createFeed(const YGConfigRef config, const uint32_t count) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  for (uint32_t i = 0; i < count; i++) {
+    const YGNodeRef card = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexDirection(card, YGFlexDirectionRow);
+    YGNodeStyleSetPadding(card, YGEdgeAll, 8);
+    const YGNodeRef image = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidth(image, 48);
+    YGNodeStyleSetHeight(image, 48);
+    YGNodeInsertChild(card, image, 0);
+    const YGNodeRef text = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexGrow(text, 1);
+    for (uint32_t j = 0; j < 2; j++) {
+      const YGNodeRef label = YGNodeNewWithConfig(config);
+      YGNodeSetMeasureFunc(label, _measure);
+      YGNodeSetContentKey(label, 1);
+      YGNodeInsertChild(text, label, j);
+    }
+    YGNodeInsertChild(card, text, 1);
+    YGNodeInsertChild(root, card, i);
+  }
+  return root;
+}
+
+YGBENCHMARKS({
+  YGBENCHMARK("Stack with flex", {
+    const YGNodeRef root = YGNodeNew();
+    YGNodeStyleSetWidth(root, 100);
+    YGNodeStyleSetHeight(root, 100);
+
+    for (uint32_t i = 0; i < 10; i++) {
+      const YGNodeRef child = YGNodeNew();
+      YGNodeSetMeasureFunc(child, _measure);
+      YGNodeStyleSetFlex(child, 1);
+      YGNodeInsertChild(root, child, 0);
+    }
+
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+    YGNodeFreeRecursive(root);
+  });
+
+  YGBENCHMARK("Nested flex", {
+    const YGNodeRef root = YGNodeNew();
+
+    for (uint32_t i = 0; i < 10; i++) {
+      const YGNodeRef child = YGNodeNew();
+      YGNodeStyleSetFlex(child, 1);
+      YGNodeInsertChild(root, child, 0);
+
+      for (uint32_t ii = 0; ii < 10; ii++) {
+        const YGNodeRef grandChild = YGNodeNew();
+        YGNodeSetMeasureFunc(grandChild, _measure);
+        YGNodeStyleSetFlex(grandChild, 1);
+        YGNodeInsertChild(child, grandChild, 0);
+      }
+    }
+
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+    YGNodeFreeRecursive(root);
+  });
+
+  const std::vector<int32_t> parents = __wideTreeParents(316);
+  const uint32_t count = static_cast<uint32_t>(parents.size());
+
+  YGBENCHMARK("Build 100k nodes with YGNodeInsertChild", {
+    std::vector<YGNodeRef> nodes(count);
+    for (uint32_t i = 0; i < count; i++) {
+      nodes[i] = YGNodeNew();
+      if (parents[i] >= 0) {
+        const YGNodeRef owner = nodes[parents[i]];
+        YGNodeInsertChild(owner, nodes[i], YGNodeGetChildCount(owner));
+      }
+    }
+    YGNodeFreeRecursive(nodes[0]);
+  });
+
+  YGBENCHMARK("Build 100k nodes with YGTreeBuild", {
+    const YGNodeRef root = YGTreeBuild(
+        YGConfigGetDefault(), count, parents.data(), nullptr, nullptr, nullptr);
+    YGNodeFreeRecursive(root);
+  });
+
+  YGBENCHMARK("Build 100k nodes in a YGNodePool", {
+    const YGNodePoolRef pool = YGNodePoolNew(YGConfigGetDefault());
+    for (uint32_t i = 0; i < count; i++) {
+      const YGNodeRef node = YGNodePoolNewNode(pool);
+      if (parents[i] >= 0) {
+        const YGNodeRef owner = YGNodePoolGetNode(pool, parents[i]);
+        YGNodeInsertChild(owner, node, YGNodeGetChildCount(owner));
+      }
+    }
+    YGNodePoolFree(pool);
+  });
+
+  // Every node is visited on each pass, so this is dominated by how many
+  // cache lines each child costs rather than by the flexbox arithmetic.
+  const YGNodeRef wideTree = YGTreeBuild(
+      YGConfigGetDefault(), count, parents.data(), nullptr, nullptr, nullptr);
+  YGBENCHMARK("Relayout 100k nodes", {
+    YGNodeMarkDirtyAndPropogateToDescendants(wideTree);
+    YGNodeCalculateLayout(wideTree, 320, YGUndefined, YGDirectionLTR);
+  });
+  YGNodeFreeRecursive(wideTree);
+
+  YGBENCHMARK("Grid of 1000 identical tiles", {
+    const YGNodeRef root = YGNodeNew();
+    YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+    YGNodeStyleSetFlexWrap(root, YGWrapWrap);
+    YGNodeStyleSetWidth(root, 320);
+
+    for (uint32_t i = 0; i < 1000; i++) {
+      const YGNodeRef tile = YGNodeNew();
+      YGNodeStyleSetWidth(tile, 78);
+      YGNodeStyleSetHeight(tile, 78);
+      YGNodeStyleSetMargin(tile, YGEdgeAll, 1);
+      YGNodeInsertChild(root, tile, i);
+    }
+
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+    YGNodeFreeRecursive(root);
+  });
+
+  // Tags of different widths. Each pass resizes the container, which keeps
+  // the lines before the first one that no longer fits.
+  const YGNodeRef tags = YGNodeNew();
+  YGNodeStyleSetFlexDirection(tags, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(tags, YGWrapWrap);
+  for (uint32_t i = 0; i < 2000; i++) {
+    const YGNodeRef tag = YGNodeNew();
+    YGNodeStyleSetWidth(tag, 20 + (i * 7) % 40);
+    YGNodeStyleSetHeight(tag, 20);
+    YGNodeStyleSetMargin(tag, YGEdgeAll, 2);
+    YGNodeInsertChild(tags, tag, i);
+  }
+  uint32_t tagsPass = 0;
+  YGBENCHMARK("Relayout 2000 wrapped tags at a new width", {
+    YGNodeStyleSetWidth(tags, 320 + (tagsPass++ % 8) * 10);
+    YGNodeCalculateLayout(tags, YGUndefined, YGUndefined, YGDirectionLTR);
+  });
+  YGNodeFreeRecursive(tags);
+
+  // Mostly bounding sizes and checking for undefined values: flexible
+  // children with min and max sizes, some of them undefined or percentages.
+  const YGNodeRef bounded = YGNodeNew();
+  YGNodeStyleSetWidth(bounded, 320);
+  YGNodeStyleSetHeight(bounded, 20000);
+  for (uint32_t i = 0; i < 1000; i++) {
+    const YGNodeRef child = YGNodeNew();
+    YGNodeStyleSetFlexGrow(child, 1);
+    YGNodeStyleSetFlexShrink(child, 1);
+    YGNodeStyleSetMinHeight(child, i % 3 == 0 ? YGUndefined : 5 + i % 7);
+    YGNodeStyleSetMaxHeightPercent(child, 1 + i % 5);
+    YGNodeStyleSetMinWidth(child, 10);
+    YGNodeStyleSetMaxWidth(child, i % 2 == 0 ? YGUndefined : 300);
+    YGNodeStyleSetPadding(child, YGEdgeAll, 1);
+    YGNodeInsertChild(bounded, child, i);
+  }
+  YGBENCHMARK("Relayout 1000 children with min and max sizes", {
+    YGNodeMarkDirtyAndPropogateToDescendants(bounded);
+    YGNodeCalculateLayout(bounded, YGUndefined, YGUndefined, YGDirectionLTR);
+  });
+  YGNodeFreeRecursive(bounded);
+
+  YGNodeRef cells = nullptr;
+  YGALLOCBENCHMARK("Build 100 cells", { cells = __createCellTree(); });
+
+  std::vector<YGNodeRef> clones;
+  clones.reserve(YGNodeGetChildCount(cells) + 1);
+  YGALLOCBENCHMARK("Clone 100 cells", {
+    clones.push_back(YGNodeClone(cells));
+    for (uint32_t i = 0; i < YGNodeGetChildCount(cells); i++) {
+      clones.push_back(YGNodeClone(YGNodeGetChild(cells, i)));
+    }
+  });
+  for (const YGNodeRef clone : clones) {
+    // Clones share their children with the originals; detach them first so
+    // that freeing the clone leaves the original tree intact.
+    YGNodeRemoveAllChildren(clone);
+    YGNodeFree(clone);
+  }
+
+  YGALLOCBENCHMARK("Tear down 100 cells", { YGNodeFreeRecursive(cells); });
+
+  const uint32_t treeCount = 64;
+  std::vector<YGNodeRef> trees(treeCount);
+  std::vector<YGLayoutConstraints> constraints(treeCount);
+  for (uint32_t i = 0; i < treeCount; i++) {
+    trees[i] = __createCellTree();
+    constraints[i] = {320, YGUndefined, YGDirectionLTR};
+  }
+
+  YGBENCHMARK("Layout 64 trees one by one", {
+    for (uint32_t i = 0; i < treeCount; i++) {
+      YGNodeMarkDirtyAndPropogateToDescendants(trees[i]);
+      YGNodeCalculateLayout(trees[i], 320, YGUndefined, YGDirectionLTR);
+    }
+  });
+
+  YGBENCHMARK("Layout 64 trees with YGNodeCalculateLayoutBatch", {
+    for (uint32_t i = 0; i < treeCount; i++) {
+      YGNodeMarkDirtyAndPropogateToDescendants(trees[i]);
+    }
+    const YGExecutor executor = {__threadPoolParallelFor, nullptr};
+    YGNodeCalculateLayoutBatch(
+        trees.data(), constraints.data(), treeCount, &executor);
+  });
+
+  for (const YGNodeRef tree : trees) {
+    YGNodeFreeRecursive(tree);
+  }
+
+  for (const bool memoize : {false, true}) {
+    const YGConfigRef config = YGConfigNew();
+    YGConfigSetMemoizeIdenticalSubtrees(config, memoize);
+    const YGNodeRef feed = __createFeed(config, 1000);
+    YGBENCHMARK(
+        memoize ? "Feed of 1000 identical cards, memoized"
+                : "Feed of 1000 identical cards",
+        {
+          YGNodeMarkDirtyAndPropogateToDescendants(feed);
+          YGNodeCalculateLayout(feed, 320, YGUndefined, YGDirectionLTR);
+        });
+    YGNodeFreeRecursive(feed);
+    YGConfigFree(config);
+  }
+
+  // Cards and their text stretch across a container of definite width, so
+  // each is laid out once rather than measured and then laid out again.
+  const YGConfigRef statsConfig = YGConfigNew();
+  const YGNodeRef statsFeed = __createFeed(statsConfig, 1000);
+  YGSTATSBENCHMARK("Relayout feed of 1000 cards", statsConfig, {
+    YGNodeMarkDirtyAndPropogateToDescendants(statsFeed);
+    YGNodeCalculateLayout(statsFeed, 320, YGUndefined, YGDirectionLTR);
+  });
+  YGNodeFreeRecursive(statsFeed);
+  YGConfigFree(statsConfig);
+
+  // Every layout, or one in ten, is laid out again without the legacy stretch
+  // behaviour on a copy of the tree.
+  for (const uint32_t samplingRate : {1u, 10u}) {
+    const YGConfigRef config = YGConfigNew();
+    YGConfigSetUseLegacyStretchBehaviour(config, true);
+    YGConfigSetShouldDiffLayoutWithoutLegacyStretchBehaviour(config, true);
+    YGConfigSetLegacyStretchDiffSamplingRate(config, samplingRate);
+    const YGNodeRef feed = __createFeed(config, 1000);
+    YGBENCHMARK(
+        samplingRate == 1
+            ? "Feed of 1000 cards, diffing the legacy stretch behaviour"
+            : "Feed of 1000 cards, diffing one layout in ten",
+        {
+          YGNodeMarkDirtyAndPropogateToDescendants(feed);
+          YGNodeCalculateLayout(feed, 320, YGUndefined, YGDirectionLTR);
+        });
+    YGNodeFreeRecursive(feed);
+    YGConfigFree(config);
+  }
+});
@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/YGMarker.h>
+#include <yoga/Yoga.h>
+
+static int _skippedAbsoluteLayouts = 0;
+
+static void* _startMarker(YGMarker, YGNodeRef, YGMarkerData) {
+  return nullptr;
+}
+
+static void _endMarker(YGMarker marker, YGNodeRef, YGMarkerData data, void*) {
+  if (marker == YGMarkerLayout) {
+    _skippedAbsoluteLayouts = data.layout->skippedAbsoluteLayouts;
+  }
+}
+
+// A card with some content, a badge in its top right corner and an overlay
+// covering it.
+static YGNodeRef _createCard(const YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+  YGNodeStyleSetBorder(root, YGEdgeAll, 2);
+
+  const YGNodeRef content = YGNodeNewWithConfig(config);
+  YGNodeStyleSetHeight(content, 20);
+  YGNodeInsertChild(root, content, 0);
+
+  const YGNodeRef badge = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPositionType(badge, YGPositionTypeAbsolute);
+  YGNodeStyleSetPosition(badge, YGEdgeTop, 0);
+  YGNodeStyleSetPosition(badge, YGEdgeRight, 0);
+  YGNodeStyleSetWidth(badge, 10);
+  YGNodeStyleSetHeight(badge, 10);
+  YGNodeInsertChild(root, badge, 1);
+
+  const YGNodeRef overlay = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPositionType(overlay, YGPositionTypeAbsolute);
+  YGNodeStyleSetPosition(overlay, YGEdgeAll, 0);
+  const YGNodeRef label = YGNodeNewWithConfig(config);
+  YGNodeStyleSetHeight(label, 10);
+  YGNodeInsertChild(overlay, label, 0);
+  YGNodeInsertChild(root, overlay, 2);
+  return root;
+}
+
+TEST(YogaTest, absolute_children_are_skipped_when_owner_size_is_unchanged) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetMarkerCallbacks(config, {_startMarker, _endMarker});
+  const YGNodeRef root = _createCard(config);
+  const YGNodeRef content = YGNodeGetChild(root, 0);
+  const YGNodeRef badge = YGNodeGetChild(root, 1);
+  const YGNodeRef overlay = YGNodeGetChild(root, 2);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, _skippedAbsoluteLayouts);
+
+  // The root is laid out again, but its size is the same.
+  YGNodeStyleSetHeight(content, 30);
+  YGNodeSetHasNewLayout(badge, false);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(2, _skippedAbsoluteLayouts);
+  ASSERT_TRUE(YGNodeGetHasNewLayout(badge));
+  ASSERT_FLOAT_EQ(88, YGNodeLayoutGetLeft(badge));
+  ASSERT_FLOAT_EQ(2, YGNodeLayoutGetTop(badge));
+  ASSERT_FLOAT_EQ(10, YGNodeLayoutGetWidth(badge));
+  ASSERT_FLOAT_EQ(2, YGNodeLayoutGetLeft(overlay));
+  ASSERT_FLOAT_EQ(96, YGNodeLayoutGetWidth(overlay));
+  ASSERT_FLOAT_EQ(96, YGNodeLayoutGetHeight(overlay));
+
+  // A changed child is laid out again.
+  YGNodeStyleSetWidth(badge, 20);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(1, _skippedAbsoluteLayouts);
+  ASSERT_FLOAT_EQ(78, YGNodeLayoutGetLeft(badge));
+  ASSERT_FLOAT_EQ(20, YGNodeLayoutGetWidth(badge));
+
+  // So is every child of a resized owner.
+  YGNodeStyleSetWidth(root, 120);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, _skippedAbsoluteLayouts);
+  ASSERT_FLOAT_EQ(98, YGNodeLayoutGetLeft(badge));
+  ASSERT_FLOAT_EQ(116, YGNodeLayoutGetWidth(overlay));
+  ASSERT_FLOAT_EQ(116, YGNodeLayoutGetWidth(YGNodeGetChild(overlay, 0)));
+
+  // Or of an owner whose borders changed.
+  YGNodeStyleSetBorder(root, YGEdgeAll, 4);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, _skippedAbsoluteLayouts);
+  ASSERT_FLOAT_EQ(112, YGNodeLayoutGetWidth(overlay));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+
+static uint32_t _baselineCalls = 0;
+
+static float _countingBaseline(
+    YGNodeRef node,
+    const float width,
+    const float height) {
+  _baselineCalls++;
+  return height / 2;
+}
+
+TEST(YogaTest, align_baseline_calls_baseline_func_once_per_layout) {
+  const YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(root, YGWrapWrap);
+  YGNodeStyleSetAlignItems(root, YGAlignBaseline);
+  YGNodeStyleSetWidth(root, 100);
+
+  for (uint32_t i = 0; i < 3; i++) {
+    const YGNodeRef child = YGNodeNew();
+    YGNodeStyleSetWidth(child, 30);
+    YGNodeStyleSetHeight(child, 10 * (i + 1));
+    const YGNodeRef text = YGNodeNew();
+    YGNodeStyleSetHeight(text, 10 * (i + 1));
+    YGNodeSetBaselineFunc(text, _countingBaseline);
+    YGNodeInsertChild(child, text, 0);
+    YGNodeInsertChild(root, child, i);
+  }
+
+  _baselineCalls = 0;
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(3u, _baselineCalls);
+  ASSERT_FLOAT_EQ(10, YGNodeLayoutGetTop(YGNodeGetChild(root, 0)));
+  ASSERT_FLOAT_EQ(5, YGNodeLayoutGetTop(YGNodeGetChild(root, 1)));
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetTop(YGNodeGetChild(root, 2)));
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, align_self_baseline_set_after_layout_is_applied) {
+  const YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetAlignItems(root, YGAlignFlexStart);
+  YGNodeStyleSetWidth(root, 100);
+
+  for (uint32_t i = 0; i < 2; i++) {
+    const YGNodeRef child = YGNodeNew();
+    YGNodeStyleSetWidth(child, 30);
+    YGNodeStyleSetHeight(child, 20 * (i + 1));
+    YGNodeSetBaselineFunc(child, _countingBaseline);
+    YGNodeInsertChild(root, child, i);
+  }
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetTop(YGNodeGetChild(root, 0)));
+
+  // The first child is already dirty when the second one changes, so only
+  // the second one's change reaches the root.
+  YGNodeStyleSetHeight(YGNodeGetChild(root, 0), 10);
+  for (uint32_t i = 0; i < 2; i++) {
+    YGNodeStyleSetAlignSelf(YGNodeGetChild(root, i), YGAlignBaseline);
+  }
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(15, YGNodeLayoutGetTop(YGNodeGetChild(root, 0)));
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetTop(YGNodeGetChild(root, 1)));
+
+  YGNodeFreeRecursive(root);
+}
@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Utils.h>
+
+using facebook::yoga::detail::CompactValue;
+
+static void _assertResolvesLikeYGValue(const CompactValue value) {
+  for (const float ownerSize : {0.0f, 375.0f, -12.5f, YGUndefined}) {
+    const float expected = YGResolveValue((YGValue) value, ownerSize).unwrap();
+    const float actual = value.resolve(ownerSize);
+    if (yoga::isUndefined(expected)) {
+      ASSERT_TRUE(yoga::isUndefined(actual));
+    } else {
+      ASSERT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST(YogaTest, compact_value_resolves_like_yg_value) {
+  ASSERT_EQ(12.5f, CompactValue::of<YGUnitPoint>(12.5f).resolve(YGUndefined));
+  ASSERT_EQ(30.0f, CompactValue::of<YGUnitPercent>(10).resolve(300));
+  ASSERT_EQ(0.0f, CompactValue::ofZero().resolve(YGUndefined));
+  ASSERT_TRUE(yoga::isUndefined(CompactValue::ofAuto().resolve(100)));
+  ASSERT_TRUE(yoga::isUndefined(CompactValue::ofUndefined().resolve(100)));
+
+  for (const float value : {0.0f,
+                            -0.0f,
+                            1.0f,
+                            -1.0f,
+                            33.3f,
+                            -250.75f,
+                            CompactValue::LOWER_BOUND,
+                            CompactValue::UPPER_BOUND_PERCENT,
+                            CompactValue::UPPER_BOUND_POINT}) {
+    _assertResolvesLikeYGValue(CompactValue::of<YGUnitPoint>(value));
+    _assertResolvesLikeYGValue(CompactValue::of<YGUnitPercent>(value));
+  }
+  _assertResolvesLikeYGValue(CompactValue::ofAuto());
+  _assertResolvesLikeYGValue(CompactValue::ofUndefined());
+}
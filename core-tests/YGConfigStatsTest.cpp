@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+
+static uint64_t _measureCount = 0;
+
+static YGSize _measure(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  _measureCount++;
+  return YGSize{widthMode == YGMeasureModeUndefined ? 10 : width, 10};
+}
+
+static YGNodeRef _createTree(const YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetAlignItems(root, YGAlignFlexStart);
+  for (uint32_t i = 0; i < 3; i++) {
+    const YGNodeRef row = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+    for (uint32_t j = 0; j < 2; j++) {
+      const YGNodeRef label = YGNodeNewWithConfig(config);
+      YGNodeSetMeasureFunc(label, _measure);
+      YGNodeStyleSetFlexGrow(label, 1);
+      YGNodeInsertChild(row, label, j);
+    }
+    YGNodeInsertChild(root, row, i);
+  }
+  return root;
+}
+
+TEST(YogaTest, config_stats_count_layout_work) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef root = _createTree(config);
+  ASSERT_GT(YGConfigGetStats(config).bytesAllocated, 0u);
+
+  _measureCount = 0;
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  const YGConfigStats first = YGConfigGetStats(config);
+  ASSERT_EQ(1u, first.layoutPasses);
+  ASSERT_EQ(_measureCount, first.measureCalls);
+  ASSERT_GT(first.cacheMisses, 0u);
+  ASSERT_EQ(first.cacheHits + first.cacheMisses, first.nodesVisited);
+  ASSERT_GE(first.nodesVisited, 10u);
+
+  // Nothing is dirty: the second pass only hits the root's cache.
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  const YGConfigStats second = YGConfigGetStats(config);
+  ASSERT_EQ(2u, second.layoutPasses);
+  ASSERT_EQ(first.measureCalls, second.measureCalls);
+  ASSERT_EQ(first.cacheMisses, second.cacheMisses);
+  ASSERT_EQ(first.cacheHits + 1, second.cacheHits);
+  ASSERT_GE(second.layoutTimeNs, first.layoutTimeNs);
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, config_stats_count_clones_and_allocations) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef node = YGNodeNewWithConfig(config);
+  const uint64_t nodeBytes = YGConfigGetStats(config).bytesAllocated;
+  ASSERT_GT(nodeBytes, 0u);
+
+  const YGNodeRef clone = YGNodeClone(node);
+  const YGConfigStats stats = YGConfigGetStats(config);
+  ASSERT_EQ(1u, stats.clones);
+  ASSERT_EQ(2 * nodeBytes, stats.bytesAllocated);
+
+  YGNodeFree(clone);
+  YGNodeFree(node);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, config_stats_reset_and_copy) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef root = _createTree(config);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Copying settings into a config keeps its own counters.
+  const YGConfigRef copy = YGConfigNew();
+  YGConfigSetPointScaleFactor(config, 3);
+  YGConfigCopy(copy, config);
+  ASSERT_EQ(0u, YGConfigGetStats(copy).layoutPasses);
+  ASSERT_EQ(1u, YGConfigGetStats(config).layoutPasses);
+
+  YGConfigResetStats(config);
+  const YGConfigStats stats = YGConfigGetStats(config);
+  ASSERT_EQ(0u, stats.layoutPasses);
+  ASSERT_EQ(0u, stats.nodesVisited);
+  ASSERT_EQ(0u, stats.bytesAllocated);
+  ASSERT_EQ(0u, stats.layoutTimeNs);
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(copy);
+  YGConfigFree(config);
+}
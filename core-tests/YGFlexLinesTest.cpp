@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/YGMarker.h>
+#include <yoga/Yoga.h>
+#include <vector>
+
+static int _reusedFlexLines = 0;
+
+static void* _startMarker(YGMarker, YGNodeRef, YGMarkerData) {
+  return nullptr;
+}
+
+static void _endMarker(YGMarker marker, YGNodeRef, YGMarkerData data, void*) {
+  if (marker == YGMarkerLayout) {
+    _reusedFlexLines = data.layout->reusedFlexLines;
+  }
+}
+
+// A wrapping row of tags of different widths, and a badge that is not on any
+// line.
+static YGNodeRef _createTags(const YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(root, YGWrapWrap);
+  YGNodeStyleSetWidth(root, 100);
+  for (uint32_t i = 0; i < 40; i++) {
+    const YGNodeRef tag = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidth(tag, 10 + (i * 7) % 30);
+    YGNodeStyleSetHeight(tag, 10);
+    YGNodeStyleSetMargin(tag, YGEdgeRight, 2);
+    YGNodeInsertChild(root, tag, i);
+  }
+  const YGNodeRef badge = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPositionType(badge, YGPositionTypeAbsolute);
+  YGNodeStyleSetWidth(badge, 500);
+  YGNodeInsertChild(root, badge, 20);
+  return root;
+}
+
+// Checks the tags against breaking the lines by hand, and returns the index
+// of the first tag of each line.
+static std::vector<uint32_t> _assertLines(const YGNodeRef root) {
+  std::vector<uint32_t> lineStarts;
+  const float width = YGNodeStyleGetWidth(root).value;
+  float left = 0;
+  float top = -10;
+  for (uint32_t i = 0; i < YGNodeGetChildCount(root); i++) {
+    const YGNodeRef tag = YGNodeGetChild(root, i);
+    if (YGNodeStyleGetPositionType(tag) == YGPositionTypeAbsolute) {
+      continue;
+    }
+    const float outerWidth = YGNodeStyleGetWidth(tag).value + 2;
+    if (lineStarts.empty() || left + outerWidth > width) {
+      lineStarts.push_back(i);
+      left = 0;
+      top += 10;
+    }
+    EXPECT_FLOAT_EQ(left, YGNodeLayoutGetLeft(tag));
+    EXPECT_FLOAT_EQ(top, YGNodeLayoutGetTop(tag));
+    left += outerWidth;
+  }
+  EXPECT_FLOAT_EQ(top + 10, YGNodeLayoutGetHeight(root));
+  return lineStarts;
+}
+
+TEST(YogaTest, wrapped_lines_are_kept_until_the_first_changed_line) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetMarkerCallbacks(config, {_startMarker, _endMarker});
+  const YGNodeRef root = _createTags(config);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, _reusedFlexLines);
+  const std::vector<uint32_t> lineStarts = _assertLines(root);
+  ASSERT_LT(4u, lineStarts.size());
+
+  // Growing a tag on the fourth line keeps the three lines before it.
+  YGNodeStyleSetWidth(YGNodeGetChild(root, lineStarts[3] + 1), 30);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(3, _reusedFlexLines);
+  _assertLines(root);
+
+  // A wider container keeps the lines that still break at the same tags.
+  YGNodeStyleSetWidth(root, 101);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_LT(0, _reusedFlexLines);
+  _assertLines(root);
+
+  YGNodeStyleSetWidth(root, 67);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  _assertLines(root);
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, wrapped_lines_skip_hidden_children) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef root = _createTags(config);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  const YGNodeRef hidden = YGNodeGetChild(root, 5);
+  YGNodeStyleSetDisplay(hidden, YGDisplayNone);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeRemoveChild(root, hidden);
+  YGNodeFree(hidden);
+  _assertLines(root);
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
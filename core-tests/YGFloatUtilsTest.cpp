@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Utils.h>
+#include <limits>
+
+TEST(YogaTest, any_nan_is_undefined) {
+  ASSERT_TRUE(yoga::isUndefined(YGUndefined));
+  ASSERT_TRUE(yoga::isUndefined(-YGUndefined));
+  ASSERT_TRUE(yoga::isUndefined(std::numeric_limits<float>::signaling_NaN()));
+  ASSERT_TRUE(yoga::isUndefined(YGUndefined + 1));
+  ASSERT_TRUE(YGFloatOptional{YGUndefined * 0}.isUndefined());
+
+  ASSERT_FALSE(yoga::isUndefined(0));
+  ASSERT_FALSE(yoga::isUndefined(-0.0f));
+  ASSERT_FALSE(yoga::isUndefined(-1));
+  ASSERT_FALSE(yoga::isUndefined(std::numeric_limits<float>::infinity()));
+  ASSERT_FALSE(yoga::isUndefined(-std::numeric_limits<float>::infinity()));
+  ASSERT_FALSE(yoga::isUndefined(std::numeric_limits<float>::denorm_min()));
+}
+
+TEST(YogaTest, float_max_and_min_ignore_undefined) {
+  ASSERT_EQ(2, YGFloatMax(1, 2));
+  ASSERT_EQ(2, YGFloatMax(2, 1));
+  ASSERT_EQ(1, YGFloatMax(YGUndefined, 1));
+  ASSERT_EQ(1, YGFloatMax(1, YGUndefined));
+  ASSERT_TRUE(yoga::isUndefined(YGFloatMax(YGUndefined, YGUndefined)));
+
+  ASSERT_EQ(1, YGFloatMin(1, 2));
+  ASSERT_EQ(1, YGFloatMin(2, 1));
+  ASSERT_EQ(1, YGFloatMin(YGUndefined, 1));
+  ASSERT_EQ(1, YGFloatMin(1, YGUndefined));
+  ASSERT_TRUE(yoga::isUndefined(YGFloatMin(YGUndefined, YGUndefined)));
+
+  ASSERT_EQ(
+      YGFloatOptional{3},
+      YGFloatOptionalMax(YGFloatOptional{3}, YGFloatOptional{-3}));
+  ASSERT_EQ(
+      YGFloatOptional{3},
+      YGFloatOptionalMax(YGFloatOptional{}, YGFloatOptional{3}));
+  ASSERT_EQ(
+      YGFloatOptional{3},
+      YGFloatOptionalMax(YGFloatOptional{3}, YGFloatOptional{}));
+  ASSERT_TRUE(
+      YGFloatOptionalMax(YGFloatOptional{}, YGFloatOptional{}).isUndefined());
+}
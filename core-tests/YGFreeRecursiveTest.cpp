@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+static YGNodeRef _createTree(const uint32_t depth, const uint32_t fanout) {
+  const YGNodeRef node = YGNodeNew();
+  if (depth > 0) {
+    for (uint32_t i = 0; i < fanout; i++) {
+      YGNodeInsertChild(node, _createTree(depth - 1, fanout), i);
+    }
+  }
+  return node;
+}
+
+static int _cleanups = 0;
+
+static void _cleanup(YGNodeRef node) {
+  _cleanups++;
+}
+
+struct DeferredQueue {
+  std::vector<std::pair<YGTaskFunc, void*>> tasks;
+};
+
+static void _defer(YGTaskFunc task, void* taskContext, void* context) {
+  static_cast<DeferredQueue*>(context)->tasks.emplace_back(task, taskContext);
+}
+
+TEST(YogaTest, free_recursive_frees_the_whole_tree) {
+  const int32_t instanceCount = YGNodeGetInstanceCount();
+  const YGNodeRef owner = YGNodeNew();
+  const YGNodeRef root = _createTree(4, 5);
+  YGNodeInsertChild(owner, root, 0);
+  ASSERT_EQ(instanceCount + 1 + 781, YGNodeGetInstanceCount());
+
+  _cleanups = 0;
+  YGNodeFreeRecursiveWithCleanupFunc(root, _cleanup);
+  ASSERT_EQ(1, _cleanups);
+  ASSERT_EQ(0u, YGNodeGetChildCount(owner));
+  ASSERT_EQ(instanceCount + 1, YGNodeGetInstanceCount());
+
+  YGNodeFree(owner);
+}
+
+TEST(YogaTest, free_recursive_leaves_shared_children_alone) {
+  const YGNodeRef original = _createTree(2, 3);
+  const YGNodeRef clone = YGNodeClone(original);
+  const YGNodeRef shared = YGNodeGetChild(original, 1);
+
+  // The clone owns its new first child and shares the original's three.
+  const int32_t instanceCount = YGNodeGetInstanceCount();
+  YGNodeInsertChild(clone, _createTree(1, 2), 0);
+  ASSERT_EQ(shared, YGNodeGetChild(clone, 2));
+
+  YGNodeFreeRecursive(clone);
+  ASSERT_EQ(instanceCount - 1, YGNodeGetInstanceCount());
+  ASSERT_EQ(original, YGNodeGetOwner(shared));
+  ASSERT_EQ(3u, YGNodeGetChildCount(shared));
+
+  YGNodeFreeRecursive(original);
+}
+
+TEST(YogaTest, free_recursive_async_detaches_then_frees_on_dispatch) {
+  const int32_t instanceCount = YGNodeGetInstanceCount();
+  const YGNodeRef owner = YGNodeNew();
+  const YGNodeRef root = _createTree(3, 4);
+  YGNodeInsertChild(owner, root, 0);
+
+  DeferredQueue queue;
+  const YGDispatcher dispatcher = {_defer, &queue};
+  _cleanups = 0;
+  YGNodeFreeRecursiveAsync(root, _cleanup, &dispatcher);
+
+  ASSERT_EQ(0u, YGNodeGetChildCount(owner));
+  ASSERT_EQ(1u, queue.tasks.size());
+  ASSERT_EQ(0, _cleanups);
+  ASSERT_EQ(instanceCount + 1 + 85, YGNodeGetInstanceCount());
+
+  queue.tasks[0].first(queue.tasks[0].second, 0);
+  ASSERT_EQ(1, _cleanups);
+  ASSERT_EQ(instanceCount + 1, YGNodeGetInstanceCount());
+
+  YGNodeFree(owner);
+}
+
+TEST(YogaTest, free_recursive_async_without_dispatcher_uses_a_thread) {
+  const int32_t instanceCount = YGNodeGetInstanceCount();
+  YGNodeFreeRecursiveAsync(_createTree(3, 4), nullptr, nullptr);
+
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (YGNodeGetInstanceCount() != instanceCount &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(instanceCount, YGNodeGetInstanceCount());
+}
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+
+static void _clearHasNewLayout(const YGNodeRef node) {
+  YGNodeSetHasNewLayout(node, false);
+  for (uint32_t i = 0; i < YGNodeGetChildCount(node); i++) {
+    _clearHasNewLayout(YGNodeGetChild(node, i));
+  }
+}
+
+// A root holding a panel, which holds a row holding a label.
+static YGNodeRef _createTree() {
+  const YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+  const YGNodeRef panel = YGNodeNew();
+  YGNodeStyleSetPadding(panel, YGEdgeAll, 5);
+  const YGNodeRef row = YGNodeNew();
+  YGNodeStyleSetHeight(row, 20);
+  const YGNodeRef label = YGNodeNew();
+  YGNodeStyleSetMargin(label, YGEdgeLeft, 3);
+  YGNodeStyleSetHeight(label, 10);
+  YGNodeInsertChild(row, label, 0);
+  YGNodeInsertChild(panel, row, 0);
+  YGNodeInsertChild(root, panel, 0);
+  return root;
+}
+
+TEST(YogaTest, hidden_subtree_reads_as_zero) {
+  const YGNodeRef root = _createTree();
+  const YGNodeRef panel = YGNodeGetChild(root, 0);
+  const YGNodeRef row = YGNodeGetChild(panel, 0);
+  const YGNodeRef label = YGNodeGetChild(row, 0);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(5, YGNodeLayoutGetTop(row));
+  ASSERT_FLOAT_EQ(87, YGNodeLayoutGetWidth(label));
+  _clearHasNewLayout(root);
+
+  YGNodeStyleSetDisplay(panel, YGDisplayNone);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_TRUE(YGNodeGetHasNewLayout(panel));
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetWidth(panel));
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetPadding(panel, YGEdgeLeft));
+
+  // Descendants are not visited, but read as zero.
+  ASSERT_FALSE(YGNodeGetHasNewLayout(row));
+  ASSERT_FALSE(YGNodeGetHasNewLayout(label));
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetTop(row));
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetHeight(row));
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetWidth(label));
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetMargin(label, YGEdgeLeft));
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, hidden_subtree_is_laid_out_when_shown_again) {
+  const YGNodeRef root = _createTree();
+  const YGNodeRef panel = YGNodeGetChild(root, 0);
+  const YGNodeRef row = YGNodeGetChild(panel, 0);
+  const YGNodeRef label = YGNodeGetChild(row, 0);
+  YGNodeStyleSetDisplay(panel, YGDisplayNone);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetWidth(label));
+
+  YGNodeStyleSetDisplay(panel, YGDisplayFlex);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(100, YGNodeLayoutGetWidth(panel));
+  ASSERT_FLOAT_EQ(5, YGNodeLayoutGetTop(row));
+  ASSERT_FLOAT_EQ(3, YGNodeLayoutGetLeft(label));
+  ASSERT_FLOAT_EQ(87, YGNodeLayoutGetWidth(label));
+
+  // Hidden after a layout, then shown again: the descendants that were not
+  // laid out again are still flagged, as they may have been read as zero.
+  _clearHasNewLayout(root);
+  YGNodeStyleSetDisplay(panel, YGDisplayNone);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeStyleSetDisplay(panel, YGDisplayFlex);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_TRUE(YGNodeGetHasNewLayout(row));
+  ASSERT_TRUE(YGNodeGetHasNewLayout(label));
+  ASSERT_FLOAT_EQ(87, YGNodeLayoutGetWidth(label));
+
+  YGNodeFreeRecursive(root);
+}
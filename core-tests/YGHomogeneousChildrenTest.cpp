@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+
+struct ContainerStyle {
+  YGFlexDirection flexDirection;
+  YGWrap flexWrap;
+  YGAlign alignItems;
+  YGAlign alignContent;
+  YGDirection direction;
+};
+
+// The container holds `count` tiles of the same style, inside a root that is
+// sized by its content so that the container is measured before it is laid
+// out. With `breakHomogeneity`, the last tile sets an explicit flexShrink of
+// 0: its style differs, which disables the fast path, but it lays out the same.
+static YGNodeRef _createGrid(
+    const YGConfigRef config,
+    const ContainerStyle& containerStyle,
+    const uint32_t count,
+    const bool breakHomogeneity) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetAlignItems(root, YGAlignFlexStart);
+
+  const YGNodeRef container = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(container, containerStyle.flexDirection);
+  YGNodeStyleSetFlexWrap(container, containerStyle.flexWrap);
+  YGNodeStyleSetAlignItems(container, containerStyle.alignItems);
+  YGNodeStyleSetAlignContent(container, containerStyle.alignContent);
+  YGNodeStyleSetMaxWidth(container, 301.7f);
+  YGNodeStyleSetMaxHeight(container, 257.3f);
+  YGNodeStyleSetPadding(container, YGEdgeAll, 3.3f);
+  YGNodeStyleSetBorder(container, YGEdgeLeft, 1.1f);
+  YGNodeInsertChild(root, container, 0);
+
+  for (uint32_t i = 0; i < count; i++) {
+    const YGNodeRef tile = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidth(tile, 31.3f);
+    YGNodeStyleSetHeight(tile, 17.9f);
+    YGNodeStyleSetMargin(tile, YGEdgeAll, 1.7f);
+    YGNodeStyleSetMargin(tile, YGEdgeStart, 2.9f);
+    YGNodeStyleSetPadding(tile, YGEdgeAll, 2);
+    if (breakHomogeneity && i == count - 1) {
+      YGNodeStyleSetFlexShrink(tile, 0);
+    }
+
+    const YGNodeRef content = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexGrow(content, 1);
+    YGNodeStyleSetMargin(content, YGEdgeTop, i % 3);
+    YGNodeInsertChild(tile, content, 0);
+
+    YGNodeInsertChild(container, tile, i);
+  }
+  return root;
+}
+
+static void _expectSameLayout(const YGNodeRef a, const YGNodeRef b) {
+  ASSERT_EQ(YGNodeLayoutGetLeft(a), YGNodeLayoutGetLeft(b));
+  ASSERT_EQ(YGNodeLayoutGetTop(a), YGNodeLayoutGetTop(b));
+  ASSERT_EQ(YGNodeLayoutGetWidth(a), YGNodeLayoutGetWidth(b));
+  ASSERT_EQ(YGNodeLayoutGetHeight(a), YGNodeLayoutGetHeight(b));
+  ASSERT_EQ(YGNodeLayoutGetHadOverflow(a), YGNodeLayoutGetHadOverflow(b));
+  ASSERT_EQ(YGNodeGetChildCount(a), YGNodeGetChildCount(b));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(a); i++) {
+    _expectSameLayout(YGNodeGetChild(a, i), YGNodeGetChild(b, i));
+  }
+}
+
+TEST(YogaTest, homogeneous_children_match_general_layout) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetPointScaleFactor(config, 0);
+
+  const ContainerStyle styles[] = {
+      {YGFlexDirectionRow, YGWrapWrap, YGAlignFlexStart, YGAlignFlexStart,
+       YGDirectionLTR},
+      {YGFlexDirectionRow, YGWrapWrap, YGAlignStretch, YGAlignStretch,
+       YGDirectionRTL},
+      {YGFlexDirectionRow, YGWrapNoWrap, YGAlignStretch, YGAlignFlexStart,
+       YGDirectionLTR},
+      {YGFlexDirectionColumn, YGWrapWrap, YGAlignFlexStart, YGAlignCenter,
+       YGDirectionLTR},
+      {YGFlexDirectionColumn, YGWrapNoWrap, YGAlignStretch, YGAlignFlexStart,
+       YGDirectionRTL},
+      {YGFlexDirectionRowReverse, YGWrapWrapReverse, YGAlignFlexStart,
+       YGAlignSpaceBetween, YGDirectionLTR},
+      {YGFlexDirectionColumnReverse, YGWrapWrap, YGAlignStretch,
+       YGAlignSpaceAround, YGDirectionLTR},
+  };
+  const float availableWidths[] = {YGUndefined, 250, 1000};
+
+  for (const ContainerStyle& style : styles) {
+    for (const float availableWidth : availableWidths) {
+      const YGNodeRef fast = _createGrid(config, style, 40, false);
+      const YGNodeRef general = _createGrid(config, style, 40, true);
+
+      YGNodeCalculateLayout(fast, availableWidth, YGUndefined, style.direction);
+      YGNodeCalculateLayout(
+          general, availableWidth, YGUndefined, style.direction);
+      _expectSameLayout(general, fast);
+
+      YGNodeFreeRecursive(fast);
+      YGNodeFreeRecursive(general);
+    }
+  }
+
+  YGConfigFree(config);
+}
+
+static uint32_t _measures = 0;
+
+static void* _startMarker(YGMarker, YGNodeRef, YGMarkerData) {
+  return nullptr;
+}
+
+static void _endMarker(YGMarker marker, YGNodeRef, YGMarkerData data, void*) {
+  if (marker == YGMarkerLayout) {
+    _measures = data.layout->measures;
+  }
+}
+
+TEST(YogaTest, homogeneous_children_are_measured_once) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetMarkerCallbacks(config, {_startMarker, _endMarker});
+  const ContainerStyle style = {YGFlexDirectionRow,
+                                YGWrapWrap,
+                                YGAlignFlexStart,
+                                YGAlignFlexStart,
+                                YGDirectionLTR};
+
+  const YGNodeRef fast = _createGrid(config, style, 100, false);
+  YGNodeCalculateLayout(fast, YGUndefined, YGUndefined, YGDirectionLTR);
+  const uint32_t fastMeasures = _measures;
+
+  const YGNodeRef general = _createGrid(config, style, 100, true);
+  YGNodeCalculateLayout(general, YGUndefined, YGUndefined, YGDirectionLTR);
+  const uint32_t generalMeasures = _measures;
+
+  ASSERT_LT(fastMeasures + 50, generalMeasures);
+  _expectSameLayout(general, fast);
+
+  YGNodeFreeRecursive(fast);
+  YGNodeFreeRecursive(general);
+  YGConfigFree(config);
+}
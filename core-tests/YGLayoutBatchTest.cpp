@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <thread>
+#include <vector>
+
+static void _threadParallelFor(
+    uint32_t count,
+    YGTaskFunc task,
+    void* taskContext,
+    void* executorContext) {
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < count; i++) {
+    threads.emplace_back([=]() { task(taskContext, i); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+static YGNodeRef _createTree(const YGConfigRef config, const float itemHeight) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  for (uint32_t i = 0; i < 20; i++) {
+    const YGNodeRef row = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+    YGNodeStyleSetHeight(row, itemHeight);
+    for (uint32_t j = 0; j < 4; j++) {
+      const YGNodeRef item = YGNodeNewWithConfig(config);
+      YGNodeStyleSetFlexGrow(item, 1);
+      YGNodeInsertChild(row, item, j);
+    }
+    YGNodeInsertChild(root, row, i);
+  }
+  return root;
+}
+
+static void _expectSameLayout(const YGNodeRef a, const YGNodeRef b) {
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetLeft(a), YGNodeLayoutGetLeft(b));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetTop(a), YGNodeLayoutGetTop(b));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetWidth(a), YGNodeLayoutGetWidth(b));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetHeight(a), YGNodeLayoutGetHeight(b));
+  ASSERT_EQ(YGNodeGetChildCount(a), YGNodeGetChildCount(b));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(a); i++) {
+    _expectSameLayout(YGNodeGetChild(a, i), YGNodeGetChild(b, i));
+  }
+}
+
+static int _layoutMarkers = 0;
+static int _layouts = 0;
+
+static void* _startMarker(YGMarker, YGNodeRef, YGMarkerData) {
+  return nullptr;
+}
+
+static void _endMarker(YGMarker marker, YGNodeRef, YGMarkerData data, void*) {
+  if (marker == YGMarkerLayout) {
+    _layoutMarkers++;
+    _layouts = data.layout->layouts;
+  }
+}
+
+TEST(YogaTest, layout_batch_matches_individual_layouts) {
+  const YGConfigRef config = YGConfigNew();
+  const uint32_t count = 8;
+
+  std::vector<YGNodeRef> roots;
+  std::vector<YGNodeRef> expected;
+  std::vector<YGLayoutConstraints> constraints;
+  for (uint32_t i = 0; i < count; i++) {
+    const float width = 100 + 10 * i;
+    roots.push_back(_createTree(config, 10 + i));
+    expected.push_back(_createTree(config, 10 + i));
+    constraints.push_back(
+        YGLayoutConstraints{width, YGUndefined, YGDirectionLTR});
+    YGNodeCalculateLayout(expected[i], width, YGUndefined, YGDirectionLTR);
+  }
+
+  const YGExecutor executor = {_threadParallelFor, nullptr};
+  YGNodeCalculateLayoutBatch(
+      roots.data(), constraints.data(), count, &executor);
+
+  for (uint32_t i = 0; i < count; i++) {
+    _expectSameLayout(expected[i], roots[i]);
+    YGNodeFreeRecursive(roots[i]);
+    YGNodeFreeRecursive(expected[i]);
+  }
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_batch_reports_one_aggregate_marker) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetMarkerCallbacks(config, {_startMarker, _endMarker});
+
+  // One root plus 20 rows of 4 items: 101 nodes laid out per tree.
+  const YGNodeRef roots[] = {_createTree(config, 10), _createTree(config, 20)};
+  const YGLayoutConstraints constraints[] = {
+      {100, YGUndefined, YGDirectionLTR}, {200, YGUndefined, YGDirectionRTL}};
+
+  _layoutMarkers = 0;
+  YGNodeCalculateLayoutBatch(roots, constraints, 2, nullptr);
+
+  ASSERT_EQ(1, _layoutMarkers);
+  ASSERT_EQ(202, _layouts);
+  ASSERT_FLOAT_EQ(200, YGNodeLayoutGetHeight(roots[0]));
+  ASSERT_FLOAT_EQ(400, YGNodeLayoutGetHeight(roots[1]));
+  ASSERT_EQ(YGDirectionRTL, YGNodeLayoutGetDirection(roots[1]));
+
+  YGNodeFreeRecursive(roots[0]);
+  YGNodeFreeRecursive(roots[1]);
+  YGConfigFree(config);
+}
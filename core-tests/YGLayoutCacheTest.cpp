@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <stdio.h>
+#include <string>
+
+static YGNodeRef _createTree(const YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetPadding(root, YGEdgeAll, 5);
+  for (uint32_t i = 0; i < 3; i++) {
+    const YGNodeRef column = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexGrow(column, i + 1);
+    YGNodeStyleSetMargin(column, YGEdgeLeft, 2);
+    for (uint32_t j = 0; j < 2; j++) {
+      const YGNodeRef cell = YGNodeNewWithConfig(config);
+      YGNodeStyleSetHeightPercent(cell, 25);
+      YGNodeInsertChild(column, cell, j);
+    }
+    YGNodeInsertChild(root, column, i);
+  }
+  return root;
+}
+
+static void _assertSameLayout(
+    const YGNodeRef expected,
+    const YGNodeRef actual) {
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetLeft(expected), YGNodeLayoutGetLeft(actual));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetTop(expected), YGNodeLayoutGetTop(actual));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetWidth(expected), YGNodeLayoutGetWidth(actual));
+  ASSERT_FLOAT_EQ(
+      YGNodeLayoutGetHeight(expected), YGNodeLayoutGetHeight(actual));
+  ASSERT_EQ(YGNodeGetChildCount(expected), YGNodeGetChildCount(actual));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(expected); i++) {
+    _assertSameLayout(YGNodeGetChild(expected, i), YGNodeGetChild(actual, i));
+  }
+}
+
+static std::string _cachePath() {
+  return testing::TempDir() + "YGLayoutCacheTest.cache";
+}
+
+TEST(YogaTest, structural_hash_covers_styles_and_topology) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef a = _createTree(config);
+  const YGNodeRef b = _createTree(config);
+  ASSERT_EQ(YGNodeGetStructuralHash(a), YGNodeGetStructuralHash(b));
+
+  YGNodeStyleSetHeightPercent(YGNodeGetChild(YGNodeGetChild(b, 2), 1), 30);
+  ASSERT_NE(YGNodeGetStructuralHash(a), YGNodeGetStructuralHash(b));
+  YGNodeStyleSetHeightPercent(YGNodeGetChild(YGNodeGetChild(b, 2), 1), 25);
+  ASSERT_EQ(YGNodeGetStructuralHash(a), YGNodeGetStructuralHash(b));
+
+  // Moving a cell to another column keeps the node count and styles.
+  const YGNodeRef cell = YGNodeGetChild(YGNodeGetChild(b, 0), 1);
+  YGNodeRemoveChild(YGNodeGetChild(b, 0), cell);
+  YGNodeInsertChild(YGNodeGetChild(b, 1), cell, 2);
+  ASSERT_NE(YGNodeGetStructuralHash(a), YGNodeGetStructuralHash(b));
+
+  YGNodeFreeRecursive(a);
+  YGNodeFreeRecursive(b);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_cache_restores_identical_trees) {
+  const YGLayoutCacheRef cache = YGLayoutCacheNew(nullptr);
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetLayoutCache(config, cache);
+
+  const YGNodeRef first = _createTree(config);
+  YGNodeCalculateLayout(first, 300, 100, YGDirectionLTR);
+  ASSERT_EQ(1u, YGLayoutCacheGetEntryCount(cache));
+
+  YGConfigResetStats(config);
+  const YGNodeRef second = _createTree(config);
+  YGNodeCalculateLayout(second, 300, 100, YGDirectionLTR);
+  ASSERT_EQ(1u, YGConfigGetStats(config).nodesVisited);
+  ASSERT_EQ(1u, YGLayoutCacheGetEntryCount(cache));
+  _assertSameLayout(first, second);
+
+  // Other constraints are a separate entry, and the restored descendants are
+  // laid out again.
+  YGNodeCalculateLayout(first, 200, 100, YGDirectionLTR);
+  YGNodeCalculateLayout(second, 200, 100, YGDirectionLTR);
+  ASSERT_EQ(2u, YGLayoutCacheGetEntryCount(cache));
+  _assertSameLayout(first, second);
+  const YGNodeRef cell = YGNodeGetChild(YGNodeGetChild(second, 0), 0);
+  // 25% of the inner height of 90 points, rounded.
+  ASSERT_FLOAT_EQ(23, YGNodeLayoutGetHeight(cell));
+
+  YGNodeFreeRecursive(first);
+  YGNodeFreeRecursive(second);
+  YGConfigFree(config);
+  YGLayoutCacheFree(cache);
+}
+
+TEST(YogaTest, layout_cache_skips_trees_with_measure_funcs) {
+  const YGLayoutCacheRef cache = YGLayoutCacheNew(nullptr);
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetLayoutCache(config, cache);
+
+  const YGNodeRef root = _createTree(config);
+  YGNodeSetMeasureFunc(
+      YGNodeGetChild(YGNodeGetChild(root, 1), 0),
+      [](YGNodeRef, float, YGMeasureMode, float, YGMeasureMode) {
+        return YGSize{10, 10};
+      });
+  YGNodeCalculateLayout(root, 300, 100, YGDirectionLTR);
+  ASSERT_EQ(0u, YGLayoutCacheGetEntryCount(cache));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+  YGLayoutCacheFree(cache);
+}
+
+TEST(YogaTest, layout_cache_round_trips_through_its_file) {
+  const std::string path = _cachePath();
+  remove(path.c_str());
+
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef expected = _createTree(config);
+  YGNodeCalculateLayout(expected, 300, 100, YGDirectionRTL);
+
+  const YGLayoutCacheRef written = YGLayoutCacheNew(path.c_str());
+  ASSERT_EQ(0u, YGLayoutCacheGetEntryCount(written));
+  YGConfigSetLayoutCache(config, written);
+  const YGNodeRef root = _createTree(config);
+  YGNodeCalculateLayout(root, 300, 100, YGDirectionRTL);
+  ASSERT_TRUE(YGLayoutCacheSave(written));
+  YGLayoutCacheFree(written);
+  YGNodeFreeRecursive(root);
+
+  const YGLayoutCacheRef loaded = YGLayoutCacheNew(path.c_str());
+  ASSERT_EQ(1u, YGLayoutCacheGetEntryCount(loaded));
+  YGConfigSetLayoutCache(config, loaded);
+  YGConfigResetStats(config);
+  const YGNodeRef restored = _createTree(config);
+  YGNodeCalculateLayout(restored, 300, 100, YGDirectionRTL);
+  ASSERT_EQ(1u, YGConfigGetStats(config).nodesVisited);
+  _assertSameLayout(expected, restored);
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(restored);
+  YGConfigFree(config);
+  YGLayoutCacheFree(loaded);
+  remove(path.c_str());
+}
+
+TEST(YogaTest, layout_cache_ignores_foreign_files) {
+  const std::string path = _cachePath();
+  FILE* file = fopen(path.c_str(), "wb");
+  ASSERT_NE(nullptr, file);
+  // The magic of a cache file followed by an unknown version.
+  const char contents[] = "YGLC\xff\xff\xff\xff garbage";
+  fwrite(contents, sizeof(contents), 1, file);
+  fclose(file);
+
+  const YGLayoutCacheRef cache = YGLayoutCacheNew(path.c_str());
+  ASSERT_EQ(0u, YGLayoutCacheGetEntryCount(cache));
+  YGLayoutCacheFree(cache);
+
+  remove(path.c_str());
+
+  const YGLayoutCacheRef inMemory = YGLayoutCacheNew(nullptr);
+  ASSERT_FALSE(YGLayoutCacheSave(inMemory));
+  YGLayoutCacheFree(inMemory);
+}
@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <map>
+
+struct LayoutChanges {
+  std::map<YGNodeRef, std::pair<YGFrame, YGFrame>> frames;
+};
+
+static void _layoutChanged(
+    YGNodeRef node,
+    YGFrame oldFrame,
+    YGFrame newFrame,
+    void* layoutContext) {
+  auto changes = static_cast<LayoutChanges*>(layoutContext);
+  changes->frames[node] = std::make_pair(oldFrame, newFrame);
+}
+
+TEST(YogaTest, layout_changed_reports_only_moved_nodes) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetLayoutChangedFunc(config, _layoutChanged);
+
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  const YGNodeRef root_child0 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root_child0, 10);
+  YGNodeInsertChild(root, root_child0, 0);
+
+  const YGNodeRef root_child1 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root_child1, 10);
+  YGNodeInsertChild(root, root_child1, 1);
+
+  const YGNodeRef root_child2 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root_child2, 10);
+  YGNodeInsertChild(root, root_child2, 2);
+
+  LayoutChanges changes;
+  YGNodeCalculateLayoutWithContext(
+      root, YGUndefined, YGUndefined, YGDirectionLTR, &changes);
+
+  ASSERT_EQ(4u, changes.frames.size());
+  ASSERT_TRUE(YGFloatIsUndefined(changes.frames[root].first.width));
+  ASSERT_FLOAT_EQ(100, changes.frames[root].second.width);
+  ASSERT_FLOAT_EQ(20, changes.frames[root_child2].second.left);
+
+  changes.frames.clear();
+  YGNodeCalculateLayoutWithContext(
+      root, YGUndefined, YGUndefined, YGDirectionLTR, &changes);
+  ASSERT_EQ(0u, changes.frames.size());
+
+  YGNodeStyleSetWidth(root_child1, 30);
+  YGNodeCalculateLayoutWithContext(
+      root, YGUndefined, YGUndefined, YGDirectionLTR, &changes);
+
+  ASSERT_EQ(2u, changes.frames.size());
+  ASSERT_EQ(0u, changes.frames.count(root));
+  ASSERT_EQ(0u, changes.frames.count(root_child0));
+
+  const YGFrame oldFrame1 = changes.frames[root_child1].first;
+  const YGFrame newFrame1 = changes.frames[root_child1].second;
+  ASSERT_FLOAT_EQ(10, oldFrame1.width);
+  ASSERT_FLOAT_EQ(30, newFrame1.width);
+  ASSERT_FLOAT_EQ(10, newFrame1.left);
+  ASSERT_FLOAT_EQ(100, newFrame1.height);
+
+  const YGFrame oldFrame2 = changes.frames[root_child2].first;
+  const YGFrame newFrame2 = changes.frames[root_child2].second;
+  ASSERT_FLOAT_EQ(20, oldFrame2.left);
+  ASSERT_FLOAT_EQ(40, newFrame2.left);
+  ASSERT_FLOAT_EQ(10, newFrame2.width);
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_changed_reports_rounded_frames) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetLayoutChangedFunc(config, _layoutChanged);
+
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 10);
+
+  const YGNodeRef root_child0 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root_child0, 10.2f);
+  YGNodeInsertChild(root, root_child0, 0);
+
+  LayoutChanges changes;
+  YGNodeCalculateLayoutWithContext(
+      root, YGUndefined, YGUndefined, YGDirectionLTR, &changes);
+  ASSERT_FLOAT_EQ(10, changes.frames[root_child0].second.width);
+
+  // Still rounds to the same frame, so nothing is reported.
+  changes.frames.clear();
+  YGNodeStyleSetWidth(root_child0, 10.3f);
+  YGNodeCalculateLayoutWithContext(
+      root, YGUndefined, YGUndefined, YGDirectionLTR, &changes);
+  ASSERT_EQ(0u, changes.frames.size());
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
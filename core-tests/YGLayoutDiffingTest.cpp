@@ -85,3 +85,77 @@ TEST(YogaTest, assert_layout_trees_are_same) {
 
   YGConfigFree(config);
 }
+
+// A row whose child holds a growing node, which the legacy stretch behaviour
+// stretches to the height of the row.
+static YGNodeRef _createLegacyStretchTree(const YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetAlignItems(root, YGAlignFlexStart);
+  YGNodeStyleSetWidth(root, 500);
+  YGNodeStyleSetHeight(root, 500);
+
+  const YGNodeRef root_child0 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetAlignItems(root_child0, YGAlignFlexStart);
+  YGNodeInsertChild(root, root_child0, 0);
+
+  const YGNodeRef root_child0_child0 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexGrow(root_child0_child0, 1);
+  YGNodeStyleSetHeight(root_child0_child0, 10);
+  YGNodeInsertChild(root_child0, root_child0_child0, 0);
+  return root;
+}
+
+TEST(YogaTest, legacy_stretch_diff_leaves_the_tree_untouched) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetUseLegacyStretchBehaviour(config, true);
+  YGConfigSetShouldDiffLayoutWithoutLegacyStretchBehaviour(config, true);
+  const YGNodeRef root = _createLegacyStretchTree(config);
+  const YGNodeRef grower = YGNodeGetChild(YGNodeGetChild(root, 0), 0);
+
+  const int32_t configInstanceCount = YGConfigGetInstanceCount();
+  const int32_t nodeInstanceCount = YGNodeGetInstanceCount();
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(configInstanceCount, YGConfigGetInstanceCount());
+  ASSERT_EQ(nodeInstanceCount, YGNodeGetInstanceCount());
+
+  ASSERT_TRUE(YGNodeLayoutGetDidUseLegacyFlag(root));
+  ASSERT_TRUE(YGNodeLayoutGetDidLegacyStretchFlagAffectLayout(root));
+  ASSERT_FLOAT_EQ(500, YGNodeLayoutGetHeight(grower));
+
+  // The diff did not turn the legacy behaviour off for the real tree.
+  YGNodeMarkDirtyAndPropogateToDescendants(root);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(500, YGNodeLayoutGetHeight(grower));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, legacy_stretch_diff_is_sampled) {
+  const YGConfigRef config = YGConfigNew();
+  YGConfigSetUseLegacyStretchBehaviour(config, true);
+  YGConfigSetShouldDiffLayoutWithoutLegacyStretchBehaviour(config, true);
+  YGConfigSetLegacyStretchDiffSamplingRate(config, 3);
+  const YGNodeRef root = _createLegacyStretchTree(config);
+  const YGNodeRef grower = YGNodeGetChild(YGNodeGetChild(root, 0), 0);
+
+  // The first layout is diffed.
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_TRUE(YGNodeLayoutGetDidLegacyStretchFlagAffectLayout(root));
+
+  // The next two keep its result, and the third one is diffed again.
+  YGNodeStyleSetFlexGrow(grower, 0);
+  for (int i = 0; i < 2; i++) {
+    YGNodeMarkDirtyAndPropogateToDescendants(root);
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+    ASSERT_TRUE(YGNodeLayoutGetDidLegacyStretchFlagAffectLayout(root));
+  }
+  YGNodeMarkDirtyAndPropogateToDescendants(root);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FALSE(YGNodeLayoutGetDidLegacyStretchFlagAffectLayout(root));
+  ASSERT_FLOAT_EQ(10, YGNodeLayoutGetHeight(grower));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+
+static YGSize _measure(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  return YGSize{widthMode == YGMeasureModeUndefined ? 10 : width, 10};
+}
+
+static YGNodeRef _createTree(const YGConfigRef config) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 200);
+  for (uint32_t i = 0; i < 10; i++) {
+    const YGNodeRef row = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+    YGNodeStyleSetPadding(row, YGEdgeAll, 2);
+    for (uint32_t j = 0; j < 3; j++) {
+      const YGNodeRef item = YGNodeNewWithConfig(config);
+      YGNodeSetMeasureFunc(item, _measure);
+      YGNodeStyleSetFlexGrow(item, j + 1);
+      YGNodeInsertChild(row, item, j);
+    }
+    YGNodeInsertChild(root, row, i);
+  }
+  return root;
+}
+
+static void _expectSameLayout(const YGNodeRef a, const YGNodeRef b) {
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetLeft(a), YGNodeLayoutGetLeft(b));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetTop(a), YGNodeLayoutGetTop(b));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetWidth(a), YGNodeLayoutGetWidth(b));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetHeight(a), YGNodeLayoutGetHeight(b));
+  ASSERT_EQ(YGNodeIsDirty(a), YGNodeIsDirty(b));
+  ASSERT_EQ(YGNodeGetChildCount(a), YGNodeGetChildCount(b));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(a); i++) {
+    _expectSameLayout(YGNodeGetChild(a, i), YGNodeGetChild(b, i));
+  }
+}
+
+TEST(YogaTest, layout_task_commits_only_when_complete) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef root = _createTree(config);
+  const YGNodeRef expected = _createTree(config);
+  YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  const YGLayoutTaskRef task =
+      YGLayoutTaskNew(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  uint32_t slices = 1;
+  while (!YGLayoutTaskRun(task, 5, 0)) {
+    ASSERT_TRUE(YGNodeIsDirty(root));
+    ASSERT_TRUE(YGFloatIsUndefined(YGNodeLayoutGetWidth(root)));
+    ASSERT_TRUE(
+        YGFloatIsUndefined(YGNodeLayoutGetWidth(YGNodeGetChild(root, 0))));
+    slices++;
+  }
+  ASSERT_GT(slices, 2u);
+  ASSERT_TRUE(YGLayoutTaskRun(task, 5, 0));
+  YGLayoutTaskFree(task);
+
+  _expectSameLayout(expected, root);
+  ASSERT_FALSE(YGNodeIsDirty(root));
+
+  YGNodeFreeRecursive(root);
+  YGNodeFreeRecursive(expected);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_task_with_budget_of_one_makes_progress) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef root = _createTree(config);
+  const YGNodeRef expected = _createTree(config);
+  YGNodeCalculateLayout(expected, 300, YGUndefined, YGDirectionRTL);
+
+  const YGLayoutTaskRef task =
+      YGLayoutTaskNew(root, 300, YGUndefined, YGDirectionRTL);
+  uint32_t slices = 1;
+  while (!YGLayoutTaskRun(task, 1, 0)) {
+    slices++;
+    ASSERT_LT(slices, 1000u);
+  }
+  YGLayoutTaskFree(task);
+
+  _expectSameLayout(expected, root);
+
+  YGNodeFreeRecursive(root);
+  YGNodeFreeRecursive(expected);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_task_without_budget_completes_in_one_slice) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef root = _createTree(config);
+
+  const YGLayoutTaskRef task =
+      YGLayoutTaskNew(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_TRUE(YGLayoutTaskRun(task, 0, 0));
+  YGLayoutTaskFree(task);
+
+  ASSERT_FLOAT_EQ(200, YGNodeLayoutGetWidth(root));
+  ASSERT_FLOAT_EQ(140, YGNodeLayoutGetHeight(root));
+
+  // A clean tree stays clean, and a later pass hits the committed cache.
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(140, YGNodeLayoutGetHeight(root));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_task_freed_early_leaves_tree_untouched) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef root = _createTree(config);
+
+  const YGLayoutTaskRef task =
+      YGLayoutTaskNew(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FALSE(YGLayoutTaskRun(task, 1, 0));
+  YGLayoutTaskFree(task);
+
+  ASSERT_TRUE(YGNodeIsDirty(root));
+  ASSERT_TRUE(YGFloatIsUndefined(YGNodeLayoutGetWidth(root)));
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(200, YGNodeLayoutGetWidth(root));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
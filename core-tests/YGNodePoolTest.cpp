@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <vector>
+
+TEST(YogaTest, node_pool_handles_are_dense_and_stable) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodePoolRef pool = YGNodePoolNew(config);
+
+  // Enough nodes to span several chunks.
+  std::vector<YGNodeRef> nodes;
+  for (uint32_t i = 0; i < 3000; i++) {
+    nodes.push_back(YGNodePoolNewNode(pool));
+  }
+  ASSERT_EQ(3000u, YGNodePoolGetNodeCount(pool));
+
+  for (uint32_t i = 0; i < 3000; i++) {
+    ASSERT_EQ(i, YGNodePoolGetHandle(pool, nodes[i]));
+    ASSERT_EQ(nodes[i], YGNodePoolGetNode(pool, i));
+  }
+  ASSERT_EQ(nullptr, YGNodePoolGetNode(pool, 3000));
+  ASSERT_EQ(nullptr, YGNodePoolGetNode(pool, YGNodeHandleUndefined));
+
+  YGNodePoolFree(pool);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, node_pool_lays_out_like_heap_nodes) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodePoolRef pool = YGNodePoolNew(config);
+
+  const YGNodeRef root = YGNodePoolNewNode(pool);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 50);
+  for (uint32_t i = 0; i < 4; i++) {
+    const YGNodeRef child = YGNodePoolNewNode(pool);
+    YGNodeStyleSetFlexGrow(child, 1);
+    YGNodeInsertChild(root, child, i);
+  }
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FLOAT_EQ(75, YGNodeLayoutGetLeft(YGNodePoolGetNode(pool, 4)));
+  ASSERT_FLOAT_EQ(25, YGNodeLayoutGetWidth(YGNodePoolGetNode(pool, 4)));
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetHeight(YGNodePoolGetNode(pool, 4)));
+
+  YGNodeHandle handles[4];
+  ASSERT_EQ(4u, YGNodePoolGetChildHandles(pool, root, handles));
+  ASSERT_EQ(1u, handles[0]);
+  ASSERT_EQ(4u, handles[3]);
+
+  YGNodePoolFree(pool);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, node_pool_clones_are_heap_nodes) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodePoolRef pool = YGNodePoolNew(config);
+  const int32_t instanceCount = YGNodeGetInstanceCount();
+
+  const YGNodeRef node = YGNodePoolNewNode(pool);
+  YGNodeStyleSetWidth(node, 10);
+  ASSERT_EQ(instanceCount + 1, YGNodeGetInstanceCount());
+
+  const YGNodeRef clone = YGNodeClone(node);
+  ASSERT_EQ(YGNodeHandleUndefined, YGNodePoolGetHandle(pool, clone));
+  ASSERT_EQ(10, YGNodeStyleGetWidth(clone).value);
+  YGNodeFree(clone);
+
+  // Resetting a pooled node keeps it in the pool.
+  YGNodeReset(node);
+  ASSERT_EQ(0u, YGNodePoolGetHandle(pool, node));
+
+  YGNodePoolFree(pool);
+  ASSERT_EQ(instanceCount, YGNodeGetInstanceCount());
+  YGConfigFree(config);
+}
@@ -31,3 +31,16 @@ TEST(YogaTest, rounding_value) {
   ASSERT_FLOAT_EQ(527.6666666, YGRoundValueToPixelGrid(527.666, 3.0, true, false));
   ASSERT_FLOAT_EQ(527.6666666, YGRoundValueToPixelGrid(527.666, 3.0, true, true));
 }
+
+TEST(YogaTest, rounding_value_negative_and_undefined) {
+  ASSERT_FLOAT_EQ(-2.0, YGRoundValueToPixelGrid(-2.2, 1.0, false, false));
+  ASSERT_FLOAT_EQ(-3.0, YGRoundValueToPixelGrid(-2.6, 1.0, false, false));
+  ASSERT_FLOAT_EQ(-2.0, YGRoundValueToPixelGrid(-2.2, 1.0, true, false));
+  ASSERT_FLOAT_EQ(-3.0, YGRoundValueToPixelGrid(-2.2, 1.0, false, true));
+  ASSERT_FLOAT_EQ(-2.5, YGRoundValueToPixelGrid(-2.49999, 2.0, false, true));
+
+  ASSERT_TRUE(YGFloatIsUndefined(
+      YGRoundValueToPixelGrid(YGUndefined, 2.0, false, false)));
+  ASSERT_TRUE(YGFloatIsUndefined(
+      YGRoundValueToPixelGrid(INFINITY, 2.0, false, false)));
+}
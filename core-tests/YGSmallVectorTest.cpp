@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/SmallVector.h>
+#include <yoga/YGNode.h>
+#include <vector>
+
+using facebook::yoga::detail::SmallVector;
+
+template <typename T, uint32_t N>
+static std::vector<T> _toStd(const SmallVector<T, N>& v) {
+  return std::vector<T>(v.begin(), v.end());
+}
+
+TEST(SmallVector, stays_inline_until_capacity_is_exceeded) {
+  SmallVector<int, 4> v;
+  ASSERT_TRUE(v.isInline());
+  ASSERT_EQ(4u, v.capacity());
+
+  for (int i = 0; i < 4; i++) {
+    v.push_back(i);
+  }
+  ASSERT_TRUE(v.isInline());
+
+  v.push_back(4);
+  ASSERT_FALSE(v.isInline());
+  ASSERT_EQ(8u, v.capacity());
+  ASSERT_EQ((std::vector<int>{0, 1, 2, 3, 4}), _toStd(v));
+}
+
+TEST(SmallVector, insert_and_erase_shift_elements) {
+  SmallVector<int, 2> v = {1, 3};
+  v.insert(v.begin() + 1, 2);
+  v.insert(v.begin(), 0);
+  v.insert(v.end(), 4);
+  ASSERT_EQ((std::vector<int>{0, 1, 2, 3, 4}), _toStd(v));
+
+  v.erase(v.begin());
+  v.erase(v.begin() + 2);
+  ASSERT_EQ((std::vector<int>{1, 2, 4}), _toStd(v));
+  ASSERT_EQ(2, v.at(1));
+  ASSERT_THROW(v.at(3), std::out_of_range);
+}
+
+TEST(SmallVector, shrink_to_fit_returns_to_inline_storage) {
+  SmallVector<int, 2> v = {1, 2, 3};
+  ASSERT_FALSE(v.isInline());
+
+  v.erase(v.begin());
+  v.shrink_to_fit();
+  ASSERT_TRUE(v.isInline());
+  ASSERT_EQ((std::vector<int>{2, 3}), _toStd(v));
+
+  v.clear();
+  ASSERT_TRUE(v.empty());
+}
+
+TEST(SmallVector, copy_and_move_keep_elements) {
+  SmallVector<int, 2> small = {1, 2};
+  SmallVector<int, 2> large = {1, 2, 3, 4};
+
+  const SmallVector<int, 2> smallCopy = small;
+  const SmallVector<int, 2> largeCopy = large;
+  ASSERT_TRUE(smallCopy.isInline());
+  ASSERT_EQ(_toStd(large), _toStd(largeCopy));
+
+  const int* heap = large.begin();
+  SmallVector<int, 2> moved = std::move(large);
+  ASSERT_EQ(heap, moved.begin());
+  ASSERT_TRUE(large.empty());
+  ASSERT_TRUE(large.isInline());
+
+  moved = std::move(small);
+  ASSERT_TRUE(moved.isInline());
+  ASSERT_EQ((std::vector<int>{1, 2}), _toStd(moved));
+}
+
+TEST(YogaTest, node_children_spill_past_inline_capacity) {
+  const YGNodeRef root = YGNodeNew();
+  for (uint32_t i = 0; i < 10; i++) {
+    YGNodeInsertChild(root, YGNodeNew(), 0);
+  }
+  ASSERT_FALSE(root->getChildren().isInline());
+
+  const YGNodeRef clone = YGNodeClone(root);
+  ASSERT_EQ(10u, YGNodeGetChildCount(clone));
+  ASSERT_EQ(YGNodeGetChild(root, 9), YGNodeGetChild(clone, 9));
+
+  while (YGNodeGetChildCount(root) > 2) {
+    const YGNodeRef child = YGNodeGetChild(root, 0);
+    YGNodeRemoveChild(root, child);
+    YGNodeFree(child);
+  }
+  ASSERT_EQ(2u, YGNodeGetChildCount(root));
+
+  YGNodeFree(clone);
+  YGNodeFreeRecursive(root);
+}
@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+
+static YGSize _measure(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  return YGSize{widthMode == YGMeasureModeUndefined ? 10 : width, 10};
+}
+
+// Rows that stretch across a column, each holding a box with a label.
+static YGNodeRef _createColumn(const YGConfigRef config, const YGWrap wrap) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexWrap(root, wrap);
+  for (uint32_t i = 0; i < 3; i++) {
+    const YGNodeRef row = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+    YGNodeStyleSetMargin(row, YGEdgeHorizontal, 5);
+    YGNodeStyleSetMaxWidth(row, 80);
+    const YGNodeRef box = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexGrow(box, 1);
+    const YGNodeRef label = YGNodeNewWithConfig(config);
+    YGNodeSetMeasureFunc(label, _measure);
+    YGNodeInsertChild(box, label, 0);
+    YGNodeInsertChild(row, box, 0);
+    YGNodeInsertChild(root, row, i);
+  }
+  return root;
+}
+
+TEST(YogaTest, stretch_children_of_a_single_line_are_laid_out_once) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef root = _createColumn(config, YGWrapNoWrap);
+  YGNodeCalculateLayout(root, 100, YGUndefined, YGDirectionLTR);
+  const YGConfigStats stats = YGConfigGetStats(config);
+
+  // With wrapping the line's cross size is only known after the children
+  // are measured, so they are laid out a second time.
+  const YGConfigRef wrapConfig = YGConfigNew();
+  const YGNodeRef wrapRoot = _createColumn(wrapConfig, YGWrapWrap);
+  YGNodeCalculateLayout(wrapRoot, 100, YGUndefined, YGDirectionLTR);
+  const YGConfigStats wrapStats = YGConfigGetStats(wrapConfig);
+
+  ASSERT_LT(stats.cacheMisses, wrapStats.cacheMisses);
+  ASSERT_EQ(stats.measureCalls, wrapStats.measureCalls);
+
+  for (uint32_t i = 0; i < 3; i++) {
+    const YGNodeRef row = YGNodeGetChild(root, i);
+    ASSERT_FLOAT_EQ(5, YGNodeLayoutGetLeft(row));
+    ASSERT_FLOAT_EQ(10 * i, YGNodeLayoutGetTop(row));
+    ASSERT_FLOAT_EQ(80, YGNodeLayoutGetWidth(row));
+    ASSERT_FLOAT_EQ(10, YGNodeLayoutGetHeight(row));
+
+    const YGNodeRef label = YGNodeGetChild(YGNodeGetChild(row, 0), 0);
+    ASSERT_FLOAT_EQ(80, YGNodeLayoutGetWidth(label));
+    ASSERT_FLOAT_EQ(
+        YGNodeLayoutGetWidth(label),
+        YGNodeLayoutGetWidth(
+            YGNodeGetChild(YGNodeGetChild(YGNodeGetChild(wrapRoot, i), 0), 0)));
+  }
+
+  YGNodeFreeRecursive(wrapRoot);
+  YGConfigFree(wrapConfig);
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+
+static void _dirtied(YGNodeRef node) {
+  int* dirtiedCount = (int*)node->getContext();
+  (*dirtiedCount)++;
+}
+
+TEST(YogaTest, style_batch_defers_dirty_until_commit) {
+  const YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  const YGNodeRef root_child0 = YGNodeNew();
+  YGNodeInsertChild(root, root_child0, 0);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  int dirtiedCount = 0;
+  root_child0->setContext(&dirtiedCount);
+  root_child0->setDirtiedFunc(_dirtied);
+
+  YGNodeStyleBeginBatch(root_child0);
+  YGNodeStyleSetWidth(root_child0, 50);
+  YGNodeStyleSetHeight(root_child0, 20);
+  YGNodeStyleSetMargin(root_child0, YGEdgeAll, 5);
+  YGNodeStyleSetFlexGrow(root_child0, 1);
+
+  ASSERT_FALSE(root_child0->isDirty());
+  ASSERT_FALSE(root->isDirty());
+  ASSERT_EQ(0, dirtiedCount);
+
+  ASSERT_TRUE(YGNodeStyleCommit(root_child0));
+  ASSERT_TRUE(root_child0->isDirty());
+  ASSERT_TRUE(root->isDirty());
+  ASSERT_EQ(1, dirtiedCount);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FLOAT_EQ(5, YGNodeLayoutGetLeft(root_child0));
+  ASSERT_FLOAT_EQ(5, YGNodeLayoutGetTop(root_child0));
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(root_child0));
+  ASSERT_FLOAT_EQ(90, YGNodeLayoutGetHeight(root_child0));
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, style_batch_without_changes_does_not_dirty) {
+  const YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  int dirtiedCount = 0;
+  root->setContext(&dirtiedCount);
+  root->setDirtiedFunc(_dirtied);
+
+  YGNodeStyleBeginBatch(root);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  ASSERT_FALSE(YGNodeStyleCommit(root));
+  ASSERT_FALSE(root->isDirty());
+  ASSERT_EQ(0, dirtiedCount);
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, style_batch_does_not_defer_tree_mutations) {
+  const YGNodeRef root = YGNodeNew();
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  YGNodeStyleBeginBatch(root);
+  const YGNodeRef root_child0 = YGNodeNew();
+  YGNodeInsertChild(root, root_child0, 0);
+
+  ASSERT_TRUE(root->isDirty());
+  ASSERT_FALSE(YGNodeStyleCommit(root));
+
+  YGNodeFreeRecursive(root);
+}
@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+
+static uint32_t _measureCount = 0;
+
+// Text of 120 points that wraps into lines of 20 points.
+static YGSize _measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  _measureCount++;
+  if (widthMode == YGMeasureModeUndefined || width >= 120) {
+    return YGSize{120, 20};
+  }
+  return YGSize{width, 20 * ceilf(120 / width)};
+}
+
+static YGNodeRef _createCard(const YGConfigRef config, const bool withKeys) {
+  const YGNodeRef card = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(card, YGFlexDirectionRow);
+  YGNodeStyleSetPadding(card, YGEdgeAll, 8);
+
+  const YGNodeRef image = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(image, 40);
+  YGNodeStyleSetHeight(image, 40);
+  YGNodeInsertChild(card, image, 0);
+
+  const YGNodeRef text = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexGrow(text, 1);
+  YGNodeStyleSetFlexShrink(text, 1);
+  for (uint32_t i = 0; i < 2; i++) {
+    const YGNodeRef label = YGNodeNewWithConfig(config);
+    YGNodeSetMeasureFunc(label, _measureText);
+    if (withKeys) {
+      YGNodeSetContentKey(label, 42);
+    }
+    YGNodeInsertChild(text, label, i);
+  }
+  YGNodeInsertChild(card, text, 1);
+  return card;
+}
+
+static YGNodeRef _createFeed(const YGConfigRef config, const bool withKeys) {
+  const YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 100);
+  for (uint32_t i = 0; i < 20; i++) {
+    YGNodeInsertChild(root, _createCard(config, withKeys), i);
+  }
+  return root;
+}
+
+static void _assertSameLayout(
+    const YGNodeRef expected,
+    const YGNodeRef actual) {
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetLeft(expected), YGNodeLayoutGetLeft(actual));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetTop(expected), YGNodeLayoutGetTop(actual));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetWidth(expected), YGNodeLayoutGetWidth(actual));
+  ASSERT_FLOAT_EQ(
+      YGNodeLayoutGetHeight(expected), YGNodeLayoutGetHeight(actual));
+  ASSERT_EQ(YGNodeGetChildCount(expected), YGNodeGetChildCount(actual));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(expected); i++) {
+    _assertSameLayout(YGNodeGetChild(expected, i), YGNodeGetChild(actual, i));
+  }
+}
+
+TEST(YogaTest, structural_hash_is_updated_incrementally) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef root = _createFeed(config, true);
+  const YGNodeRef first = YGNodeGetChild(root, 0);
+  const YGNodeRef second = YGNodeGetChild(root, 1);
+  const uint64_t rootHash = YGNodeGetStructuralHash(root);
+  ASSERT_EQ(YGNodeGetStructuralHash(first), YGNodeGetStructuralHash(second));
+
+  const YGNodeRef label = YGNodeGetChild(YGNodeGetChild(second, 1), 0);
+  YGNodeSetContentKey(label, 7);
+  ASSERT_NE(YGNodeGetStructuralHash(first), YGNodeGetStructuralHash(second));
+  ASSERT_NE(rootHash, YGNodeGetStructuralHash(root));
+  YGNodeSetContentKey(label, 42);
+  ASSERT_EQ(rootHash, YGNodeGetStructuralHash(root));
+
+  // The root is already dirty, so only the hash walk reaches it.
+  YGNodeStyleSetMargin(label, YGEdgeTop, 4);
+  ASSERT_NE(rootHash, YGNodeGetStructuralHash(root));
+  ASSERT_NE(YGNodeGetStructuralHash(first), YGNodeGetStructuralHash(second));
+  YGNodeStyleSetMargin(
+      YGNodeGetChild(YGNodeGetChild(first, 1), 0), YGEdgeTop, 4);
+  ASSERT_EQ(YGNodeGetStructuralHash(first), YGNodeGetStructuralHash(second));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, memoized_subtrees_match_full_layout) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef expected = _createFeed(config, true);
+  _measureCount = 0;
+  YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+  const uint32_t fullMeasureCount = _measureCount;
+
+  const YGConfigRef memoConfig = YGConfigNew();
+  YGConfigSetMemoizeIdenticalSubtrees(memoConfig, true);
+  const YGNodeRef root = _createFeed(memoConfig, true);
+  _measureCount = 0;
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_LT(_measureCount * 5, fullMeasureCount);
+  _assertSameLayout(expected, root);
+
+  // Changing one card relays it out on its own.
+  for (const YGNodeRef tree : {expected, root}) {
+    YGNodeStyleSetPadding(YGNodeGetChild(tree, 3), YGEdgeLeft, 20);
+    YGNodeCalculateLayout(tree, YGUndefined, YGUndefined, YGDirectionLTR);
+  }
+  _assertSameLayout(expected, root);
+  ASSERT_FLOAT_EQ(
+      20, YGNodeLayoutGetLeft(YGNodeGetChild(YGNodeGetChild(root, 3), 0)));
+  ASSERT_FLOAT_EQ(
+      8, YGNodeLayoutGetLeft(YGNodeGetChild(YGNodeGetChild(root, 4), 0)));
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+  YGConfigFree(memoConfig);
+}
+
+TEST(YogaTest, measured_nodes_without_content_key_are_not_memoized) {
+  const YGConfigRef config = YGConfigNew();
+  const YGNodeRef expected = _createFeed(config, false);
+  _measureCount = 0;
+  YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+  const uint32_t fullMeasureCount = _measureCount;
+
+  YGConfigSetMemoizeIdenticalSubtrees(config, true);
+  const YGNodeRef root = _createFeed(config, false);
+  _measureCount = 0;
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(fullMeasureCount, _measureCount);
+  _assertSameLayout(expected, root);
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
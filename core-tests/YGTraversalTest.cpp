@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// root
+//   a
+//     a0
+//     a1
+//   b
+//     b0
+static std::vector<YGNodeRef> _createTree() {
+  std::vector<YGNodeRef> nodes;
+  for (uint32_t i = 0; i < 6; i++) {
+    nodes.push_back(YGNodeNew());
+  }
+  YGNodeInsertChild(nodes[0], nodes[1], 0);
+  YGNodeInsertChild(nodes[1], nodes[2], 0);
+  YGNodeInsertChild(nodes[1], nodes[3], 1);
+  YGNodeInsertChild(nodes[0], nodes[4], 1);
+  YGNodeInsertChild(nodes[4], nodes[5], 0);
+  return nodes;
+}
+
+static void _threadParallelFor(
+    uint32_t count,
+    YGTaskFunc task,
+    void* taskContext,
+    void* executorContext) {
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < count; i++) {
+    threads.emplace_back([=]() { task(taskContext, i); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(YogaTest, visit_pre_order_in_order) {
+  const std::vector<YGNodeRef> nodes = _createTree();
+
+  std::vector<YGNodeRef> visited;
+  ASSERT_TRUE(YGVisitPreOrder(nodes[0], [&](YGNodeRef node) {
+    visited.push_back(node);
+    return YGVisitResult::Continue;
+  }));
+  ASSERT_EQ(nodes, visited);
+
+  visited.clear();
+  YGTraversePreOrder(nodes[0], [&](YGNodeRef node) { visited.push_back(node); });
+  ASSERT_EQ(nodes, visited);
+
+  YGNodeFreeRecursive(nodes[0]);
+}
+
+TEST(YogaTest, visit_pre_order_skips_and_stops) {
+  const std::vector<YGNodeRef> nodes = _createTree();
+
+  std::vector<YGNodeRef> visited;
+  ASSERT_TRUE(YGVisitPreOrder(nodes[0], [&](YGNodeRef node) {
+    visited.push_back(node);
+    return node == nodes[1] ? YGVisitResult::SkipChildren
+                            : YGVisitResult::Continue;
+  }));
+  ASSERT_EQ(
+      (std::vector<YGNodeRef>{nodes[0], nodes[1], nodes[4], nodes[5]}),
+      visited);
+
+  visited.clear();
+  ASSERT_FALSE(YGVisitPreOrder(nodes[0], [&](YGNodeRef node) {
+    visited.push_back(node);
+    return node == nodes[2] ? YGVisitResult::Stop : YGVisitResult::Continue;
+  }));
+  ASSERT_EQ((std::vector<YGNodeRef>{nodes[0], nodes[1], nodes[2]}), visited);
+
+  YGNodeFreeRecursive(nodes[0]);
+}
+
+TEST(YogaTest, visit_pre_order_handles_deep_trees) {
+  const uint32_t depth = 200000;
+  const YGNodeRef root = YGNodeNew();
+  YGNodeRef leaf = root;
+  for (uint32_t i = 0; i < depth; i++) {
+    const YGNodeRef child = YGNodeNew();
+    YGNodeInsertChild(leaf, child, 0);
+    leaf = child;
+  }
+
+  uint32_t count = 0;
+  ASSERT_TRUE(YGVisitPreOrder(root, [&](YGNodeRef node) {
+    count++;
+    return YGVisitResult::Continue;
+  }));
+  ASSERT_EQ(depth + 1, count);
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, visit_pre_order_parallel_visits_every_node_once) {
+  const YGNodeRef root = YGNodeNew();
+  for (uint32_t i = 0; i < 20; i++) {
+    const YGNodeRef row = YGNodeNew();
+    for (uint32_t j = 0; j < 10; j++) {
+      YGNodeInsertChild(row, YGNodeNew(), j);
+    }
+    YGNodeInsertChild(root, row, i);
+  }
+  const YGNodeRef skipped = YGNodeGetChild(root, 3);
+
+  std::atomic<uint32_t> count(0);
+  const YGExecutor executor = {_threadParallelFor, nullptr};
+  ASSERT_TRUE(YGVisitPreOrderParallel(
+      root,
+      [&](YGNodeRef node) {
+        count++;
+        return node == skipped ? YGVisitResult::SkipChildren
+                               : YGVisitResult::Continue;
+      },
+      &executor));
+  ASSERT_EQ(1u + 20 + 19 * 10, count.load());
+
+  ASSERT_FALSE(YGVisitPreOrderParallel(
+      root,
+      [&](YGNodeRef node) {
+        return YGNodeGetChildCount(node) == 0 ? YGVisitResult::Stop
+                                              : YGVisitResult::Continue;
+      },
+      &executor));
+
+  YGNodeFreeRecursive(root);
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+
+static YGSize _measure(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  return YGSize{10, 10};
+}
+
+TEST(YogaTest, tree_build_links_children_in_order) {
+  const YGConfigRef config = YGConfigNew();
+
+  //        0
+  //      /   \
+  //     1     2
+  //    / \
+  //   3   4
+  const int32_t parents[] = {-1, 0, 0, 1, 1};
+  YGNodeRef nodes[5];
+  const YGNodeRef root =
+      YGTreeBuild(config, 5, parents, nullptr, nullptr, nodes);
+
+  ASSERT_EQ(nodes[0], root);
+  ASSERT_EQ(nullptr, YGNodeGetOwner(root));
+  ASSERT_EQ(2u, YGNodeGetChildCount(root));
+  ASSERT_EQ(nodes[1], YGNodeGetChild(root, 0));
+  ASSERT_EQ(nodes[2], YGNodeGetChild(root, 1));
+  ASSERT_EQ(2u, YGNodeGetChildCount(nodes[1]));
+  ASSERT_EQ(nodes[3], YGNodeGetChild(nodes[1], 0));
+  ASSERT_EQ(nodes[4], YGNodeGetChild(nodes[1], 1));
+  ASSERT_EQ(nodes[1], YGNodeGetOwner(nodes[4]));
+  ASSERT_EQ(0u, YGNodeGetChildCount(nodes[2]));
+  ASSERT_LE(2u, nodes[1]->getChildren().capacity());
+
+  ASSERT_TRUE(YGNodeIsDirty(root));
+  ASSERT_FALSE(YGNodeIsDirty(nodes[3]));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, tree_build_applies_templates_and_measure_funcs) {
+  const YGConfigRef config = YGConfigNew();
+
+  const YGNodeRef rootStyle = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(rootStyle, YGFlexDirectionRow);
+  YGNodeStyleSetWidth(rootStyle, 100);
+  YGNodeStyleSetHeight(rootStyle, 100);
+
+  const YGNodeRef itemStyle = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexGrow(itemStyle, 1);
+
+  const int32_t parents[] = {-1, 0, 0};
+  const YGNodeRef templates[] = {rootStyle, itemStyle, nullptr};
+  const YGMeasureFunc measureFuncs[] = {nullptr, nullptr, _measure};
+  YGNodeRef nodes[3];
+  const YGNodeRef root =
+      YGTreeBuild(config, 3, parents, templates, measureFuncs, nodes);
+
+  ASSERT_TRUE(YGNodeHasMeasureFunc(nodes[2]));
+  ASSERT_FALSE(YGNodeHasMeasureFunc(nodes[1]));
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FLOAT_EQ(100, YGNodeLayoutGetWidth(root));
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetLeft(nodes[1]));
+  ASSERT_FLOAT_EQ(90, YGNodeLayoutGetWidth(nodes[1]));
+  ASSERT_FLOAT_EQ(100, YGNodeLayoutGetHeight(nodes[1]));
+  ASSERT_FLOAT_EQ(90, YGNodeLayoutGetLeft(nodes[2]));
+  ASSERT_FLOAT_EQ(10, YGNodeLayoutGetWidth(nodes[2]));
+
+  YGNodeFreeRecursive(root);
+  YGNodeFree(rootStyle);
+  YGNodeFree(itemStyle);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, tree_build_single_node) {
+  const int32_t parents[] = {-1};
+  const YGNodeRef root = YGTreeBuild(
+      YGConfigGetDefault(), 1, parents, nullptr, nullptr, nullptr);
+
+  ASSERT_EQ(0u, YGNodeGetChildCount(root));
+  ASSERT_TRUE(YGNodeIsDirty(root));
+
+  YGNodeFree(root);
+}
@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+
+static int _measureCount = 0;
+
+static YGSize _measure(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  _measureCount++;
+  return YGSize{widthMode == YGMeasureModeUndefined ? 10 : width, 10};
+}
+
+static YGNodeRef _createFeed(const uint32_t childCount) {
+  const YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetOverflow(root, YGOverflowScroll);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+  for (uint32_t i = 0; i < childCount; i++) {
+    const YGNodeRef child = YGNodeNew();
+    YGNodeSetMeasureFunc(child, _measure);
+    YGNodeInsertChild(root, child, i);
+  }
+  return root;
+}
+
+TEST(YogaTest, viewport_lays_out_only_visible_children) {
+  const YGNodeRef root = _createFeed(1000);
+  YGNodeSetViewport(root, YGViewport{0, 100, 0, 10});
+
+  _measureCount = 0;
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_LT(_measureCount, 50);
+
+  const YGNodeRef visible = YGNodeGetChild(root, 5);
+  ASSERT_FALSE(YGNodeLayoutGetIsVirtualized(visible));
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetTop(visible));
+  ASSERT_FLOAT_EQ(100, YGNodeLayoutGetWidth(visible));
+  ASSERT_FLOAT_EQ(10, YGNodeLayoutGetHeight(visible));
+
+  const YGNodeRef hidden = YGNodeGetChild(root, 500);
+  ASSERT_TRUE(YGNodeLayoutGetIsVirtualized(hidden));
+  ASSERT_FLOAT_EQ(5000, YGNodeLayoutGetTop(hidden));
+  ASSERT_FLOAT_EQ(100, YGNodeLayoutGetWidth(hidden));
+  ASSERT_FLOAT_EQ(10, YGNodeLayoutGetHeight(hidden));
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, viewport_scroll_lays_out_only_exposed_children) {
+  const YGNodeRef root = _createFeed(1000);
+  YGNodeSetViewport(root, YGViewport{0, 100, 0, 10});
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Moving by less than the window keeps the overlapping children cached.
+  YGNodeSetViewport(root, YGViewport{50, 100, 0, 10});
+  ASSERT_TRUE(YGNodeIsDirty(root));
+  _measureCount = 0;
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_LE(_measureCount, 10);
+  ASSERT_FALSE(YGNodeLayoutGetIsVirtualized(YGNodeGetChild(root, 14)));
+
+  YGNodeSetViewport(root, YGViewport{5000, 100, 0, 10});
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  const YGNodeRef first = YGNodeGetChild(root, 0);
+  ASSERT_TRUE(YGNodeLayoutGetIsVirtualized(first));
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetTop(first));
+  ASSERT_FLOAT_EQ(10, YGNodeLayoutGetHeight(first));
+
+  const YGNodeRef exposed = YGNodeGetChild(root, 505);
+  ASSERT_FALSE(YGNodeLayoutGetIsVirtualized(exposed));
+  ASSERT_FLOAT_EQ(5050, YGNodeLayoutGetTop(exposed));
+  ASSERT_FLOAT_EQ(10, YGNodeLayoutGetHeight(exposed));
+
+  // Setting the same viewport again doesn't dirty the container.
+  YGNodeSetViewport(root, YGViewport{5000, 100, 0, 10});
+  ASSERT_FALSE(YGNodeIsDirty(root));
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, viewport_positions_unmeasured_children_by_estimate) {
+  const YGNodeRef root = _createFeed(100);
+  YGNodeSetViewport(root, YGViewport{0, 100, 0, 20});
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Children 0 to 10 touch the window and are measured at 10 points each;
+  // the rest are estimated at 20.
+  ASSERT_FALSE(YGNodeLayoutGetIsVirtualized(YGNodeGetChild(root, 10)));
+  ASSERT_TRUE(YGNodeLayoutGetIsVirtualized(YGNodeGetChild(root, 11)));
+  ASSERT_FLOAT_EQ(110, YGNodeLayoutGetTop(YGNodeGetChild(root, 11)));
+  ASSERT_FLOAT_EQ(290, YGNodeLayoutGetTop(YGNodeGetChild(root, 20)));
+  ASSERT_FLOAT_EQ(20, YGNodeLayoutGetHeight(YGNodeGetChild(root, 20)));
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, viewport_is_ignored_without_overflow_scroll) {
+  const YGNodeRef root = _createFeed(100);
+  YGNodeStyleSetOverflow(root, YGOverflowVisible);
+  YGNodeSetViewport(root, YGViewport{0, 100, 0, 20});
+
+  _measureCount = 0;
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_GE(_measureCount, 100);
+  ASSERT_FALSE(YGNodeLayoutGetIsVirtualized(YGNodeGetChild(root, 50)));
+  ASSERT_FLOAT_EQ(500, YGNodeLayoutGetTop(YGNodeGetChild(root, 50)));
+
+  YGNodeFreeRecursive(root);
+}
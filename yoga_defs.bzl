@@ -73,6 +73,11 @@ def apple_test(*args, **kwargs):
   _original_apple_test(*args, **kwargs)
 
 
+_original_cxx_binary = cxx_binary
+def cxx_binary(*args, **kwargs):
+  _original_cxx_binary(*args, **kwargs)
+
+
 _original_cxx_library = cxx_library
 def cxx_library(*args, **kwargs):
   # Currently unused